@@ -0,0 +1,361 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+// Deque: a double-ended queue in a circular buffer.
+//
+// The elements live in one contiguous power-of-two buffer with the front at
+// head_, so the i-th element is in slot (head_ + i) & (capacity - 1): both
+// ends push and pop in O(1) and operator[] is one add and one mask. A full
+// deque doubles its buffer, moving the elements once, in order, to the
+// start of the new one. The buffer is allocated by the first push.
+//
+// The elements always form at most two contiguous runs, so the bulk
+// pushBackN and popFrontN copy with at most two block copies each.
+template<typename T>
+class Deque{
+public:
+    using size_type = std::size_t;
+
+    Deque() noexcept = default;
+    ~Deque();
+
+    Deque(const Deque& other);
+    Deque(Deque&& other) noexcept;
+    Deque& operator=(Deque other) noexcept;
+
+    template<class U>
+    void pushBack(U&& u);
+
+    template<class U>
+    void pushFront(U&& u);
+
+    void popBack();
+    void popFront();
+
+    // Appends copies of first[0, n) in order; first must not point into
+    // the deque. If a copy throws, the deque is left as it was.
+    void pushBackN(const T* first, size_type n);
+
+    // Moves up to n front elements, oldest first, into out[0, n) and
+    // removes them. Returns how many it moved.
+    size_type popFrontN(T* out, size_type n);
+
+    // Removes up to n front elements. Returns how many it removed.
+    size_type popFrontN(size_type n) noexcept;
+
+    T& operator[](size_type index);
+    const T& operator[](size_type index) const;
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    size_type size() const;
+    size_type capacity() const;
+
+    bool empty() const;
+
+    void clear() noexcept;
+
+private:
+    static constexpr size_type kInitialCapacity = 8;
+
+    size_type slot(size_type index) const noexcept { return index & (capacity_ - 1); }
+
+    // The elements as at most two contiguous runs: [head_, head_ + first)
+    // and [0, size_ - first)
+    size_type firstRun() const noexcept;
+
+    // Constructs copies, or with Move moved-from values, of the elements at
+    // the start of the uninitialized buffer to, in order
+    template<bool Move, class Source>
+    static void transferTo(Source& source, T* to);
+
+    // Grows the buffer to hold at least required elements
+    void grow(size_type required);
+    void swap(Deque& other) noexcept;
+
+private:
+    T* data_ = nullptr;             // uninitialized storage, nullptr until the first push
+    size_type capacity_ = 0;        // 0 or a power of two
+    size_type head_ = 0;            // slot of the front element
+    size_type size_ = 0;
+};
+
+template<typename T>
+Deque<T>::~Deque() {
+    clear();
+    std::allocator<T>().deallocate(data_, capacity_);
+    data_ = nullptr;
+    capacity_ = 0;
+}
+
+template<typename T>
+Deque<T>::Deque(const Deque<T>& other)
+    : capacity_(other.capacity_) {
+    if (capacity_ == 0) {
+        return;
+    }
+    data_ = std::allocator<T>().allocate(capacity_);
+    try {
+        transferTo<false>(other, data_);
+    } catch (...) {
+        std::allocator<T>().deallocate(data_, capacity_);
+        throw;
+    }
+    size_ = other.size_;
+}
+
+template<typename T>
+Deque<T>::Deque(Deque<T>&& other) noexcept
+    : data_(other.data_), capacity_(other.capacity_), head_(other.head_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+    other.head_ = 0;
+    other.size_ = 0;
+}
+
+template<typename T>
+Deque<T>& Deque<T>::operator=(Deque<T> other) noexcept {
+    swap(other);
+    return *this;
+}
+
+template<typename T>
+template<class U>
+void Deque<T>::pushBack(U&& u) {
+    if (size_ < capacity_) {
+        ::new (static_cast<void*>(data_ + slot(head_ + size_))) T(std::forward<U>(u));
+        ++size_;
+        return;
+    }
+
+    // u may be an element itself, so materialize it before growth moves it
+    T tmp(std::forward<U>(u));
+    grow(size_ + 1);
+    ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
+    ++size_;
+}
+
+template<typename T>
+template<class U>
+void Deque<T>::pushFront(U&& u) {
+    if (size_ < capacity_) {
+        size_type front = slot(head_ + capacity_ - 1);
+        ::new (static_cast<void*>(data_ + front)) T(std::forward<U>(u));
+        head_ = front;
+        ++size_;
+        return;
+    }
+
+    T tmp(std::forward<U>(u));
+    grow(size_ + 1);
+    size_type front = capacity_ - 1;            // Growth put the front at slot 0
+    ::new (static_cast<void*>(data_ + front)) T(std::move(tmp));
+    head_ = front;
+    ++size_;
+}
+
+template<typename T>
+void Deque<T>::popBack() {
+    assert(!empty() && "Deque is empty");
+    std::destroy_at(data_ + slot(head_ + size_ - 1));
+    --size_;
+}
+
+template<typename T>
+void Deque<T>::popFront() {
+    assert(!empty() && "Deque is empty");
+    std::destroy_at(data_ + head_);
+    head_ = slot(head_ + 1);
+    --size_;
+}
+
+// The free slots after the back are at most two runs as well: up to the end
+// of the buffer, then from its start
+template<typename T>
+void Deque<T>::pushBackN(const T* first, size_type n) {
+    if (n == 0) {
+        return;
+    }
+    if (n > capacity_ - size_) {
+        grow(size_ + n);
+    }
+    size_type back = slot(head_ + size_);
+    size_type toEnd = capacity_ - back;
+    size_type run = n < toEnd ? n : toEnd;
+    std::uninitialized_copy(first, first + run, data_ + back);
+    try {
+        std::uninitialized_copy(first + run, first + n, data_);
+    } catch (...) {
+        std::destroy(data_ + back, data_ + back + run);
+        throw;
+    }
+    size_ += n;
+}
+
+template<typename T>
+typename Deque<T>::size_type Deque<T>::popFrontN(T* out, size_type n) {
+    if (n > size_) {
+        n = size_;
+    }
+    size_type toEnd = capacity_ - head_;
+    size_type run = n < toEnd ? n : toEnd;
+    std::move(data_ + head_, data_ + head_ + run, out);
+    std::move(data_, data_ + (n - run), out + run);
+    return popFrontN(n);
+}
+
+template<typename T>
+typename Deque<T>::size_type Deque<T>::popFrontN(size_type n) noexcept {
+    if (n > size_) {
+        n = size_;
+    }
+    size_type toEnd = capacity_ - head_;
+    size_type run = n < toEnd ? n : toEnd;
+    std::destroy(data_ + head_, data_ + head_ + run);
+    std::destroy(data_, data_ + (n - run));
+    head_ = n == 0 ? head_ : slot(head_ + n);
+    size_ -= n;
+    return n;
+}
+
+template<typename T>
+T& Deque<T>::operator[](size_type index) {
+    assert(index < size_ && "Deque index out of range");
+    return data_[slot(head_ + index)];
+}
+
+template<typename T>
+const T& Deque<T>::operator[](size_type index) const {
+    assert(index < size_ && "Deque index out of range");
+    return data_[slot(head_ + index)];
+}
+
+template<typename T>
+T& Deque<T>::front() {
+    assert(!empty() && "Deque is empty");
+    return data_[head_];
+}
+
+template<typename T>
+const T& Deque<T>::front() const {
+    assert(!empty() && "Deque is empty");
+    return data_[head_];
+}
+
+template<typename T>
+T& Deque<T>::back() {
+    assert(!empty() && "Deque is empty");
+    return data_[slot(head_ + size_ - 1)];
+}
+
+template<typename T>
+const T& Deque<T>::back() const {
+    assert(!empty() && "Deque is empty");
+    return data_[slot(head_ + size_ - 1)];
+}
+
+template<typename T>
+typename Deque<T>::size_type Deque<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+typename Deque<T>::size_type Deque<T>::capacity() const {
+    return capacity_;
+}
+
+template<typename T>
+bool Deque<T>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T>
+void Deque<T>::clear() noexcept {
+    size_type first = firstRun();
+    std::destroy(data_ + head_, data_ + head_ + first);
+    std::destroy(data_, data_ + (size_ - first));
+    head_ = 0;
+    size_ = 0;
+}
+
+template<typename T>
+typename Deque<T>::size_type Deque<T>::firstRun() const noexcept {
+    size_type toEnd = capacity_ - head_;
+    return size_ < toEnd ? size_ : toEnd;
+}
+
+template<typename T>
+template<bool Move, class Source>
+void Deque<T>::transferTo(Source& source, T* to) {
+    auto transfer = [](T* first, T* last, T* out) {
+        if constexpr (Move) {
+            std::uninitialized_move(first, last, out);
+        } else {
+            std::uninitialized_copy(first, last, out);
+        }
+    };
+
+    size_type first = source.firstRun();
+    T* begin = source.data_ + source.head_;
+    transfer(begin, begin + first, to);
+    try {
+        transfer(source.data_, source.data_ + (source.size_ - first), to + first);
+    } catch (...) {
+        std::destroy(to, to + first);
+        throw;
+    }
+}
+
+// Moves when that cannot throw (or copying is impossible), so a failed
+// growth leaves the deque as it was
+template<typename T>
+void Deque<T>::grow(size_type required) {
+    size_type newCapacity = capacity_ == 0 ? kInitialCapacity : capacity_;
+    while (newCapacity < required) {
+        if (newCapacity * 2 < newCapacity) {
+            throw std::bad_alloc();
+        }
+        newCapacity *= 2;
+    }
+    T* newData = std::allocator<T>().allocate(newCapacity);
+    try {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>) {
+            transferTo<true>(*this, newData);
+        } else {
+            transferTo<false>(*this, newData);
+        }
+    } catch (...) {
+        std::allocator<T>().deallocate(newData, newCapacity);
+        throw;
+    }
+
+    size_type size = size_;
+    clear();
+    std::allocator<T>().deallocate(data_, capacity_);
+    data_ = newData;
+    capacity_ = newCapacity;
+    size_ = size;
+}
+
+template<typename T>
+void Deque<T>::swap(Deque<T>& other) noexcept {
+    using std::swap;
+    swap(data_, other.data_);
+    swap(capacity_, other.capacity_);
+    swap(head_, other.head_);
+    swap(size_, other.size_);
+}
+
+}
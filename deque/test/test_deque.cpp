@@ -0,0 +1,248 @@
+// test_deque.cpp
+// Catch2 unit tests for template class Deque<T> (circular buffer).
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "deque.hpp"
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ds::Deque;
+
+namespace {
+
+struct Throwing {
+    static int budget;                  // Copies allowed before one throws
+    int value;
+
+    explicit Throwing(int v) : value(v) {}
+    Throwing(const Throwing& other) : value(other.value) {
+        if (--budget < 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+    Throwing& operator=(const Throwing&) = default;
+};
+
+int Throwing::budget = 0;
+
+// Fills d so that its elements wrap around the end of the buffer
+void makeWrapped(Deque<int>& d) {
+    for (int i = 0; i < 8; ++i) {
+        d.pushBack(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        d.popFront();
+    }
+    for (int i = 8; i < 12; ++i) {
+        d.pushBack(i);                  // Deque: 6..11, slots 6, 7, 0, 1, 2, 3
+    }
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Default construction and basic state
+// -----------------------------------------------------------------------------
+TEST_CASE("Default-constructed deque is empty", "[constructor]") {
+    Deque<int> d;
+    REQUIRE(d.empty());
+    REQUIRE(d.size() == 0);
+    REQUIRE(d.capacity() == 0);
+}
+
+// -----------------------------------------------------------------------------
+// Both ends
+// -----------------------------------------------------------------------------
+TEST_CASE("push and pop at both ends", "[push][pop]") {
+    Deque<int> d;
+    d.pushBack(2);
+    d.pushFront(1);
+    d.pushBack(3);
+    d.pushFront(0);                     // Deque: 0, 1, 2, 3
+
+    REQUIRE(d.size() == 4);
+    REQUIRE(d.front() == 0);
+    REQUIRE(d.back() == 3);
+
+    d.popFront();
+    d.popBack();
+    REQUIRE(d.front() == 1);
+    REQUIRE(d.back() == 2);
+    d.popBack();
+    d.popBack();
+    REQUIRE(d.empty());
+}
+
+TEST_CASE("Random operations match std::deque", "[push][pop][index]") {
+    Deque<std::string> d;
+    std::deque<std::string> expected;
+    unsigned state = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245u + 12345u;
+        unsigned op = (state >> 16) % 5;
+        std::string value = std::to_string(i);
+        if (op == 0) {
+            d.pushBack(value);
+            expected.push_back(value);
+        } else if (op == 1) {
+            d.pushFront(value);
+            expected.push_front(value);
+        } else if (op == 2 && !expected.empty()) {
+            d.popBack();
+            expected.pop_back();
+        } else if (op == 3 && !expected.empty()) {
+            d.popFront();
+            expected.pop_front();
+        } else if (!expected.empty()) {
+            std::size_t index = state % expected.size();
+            REQUIRE(d[index] == expected[index]);
+        }
+    }
+    REQUIRE(d.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(d[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Growth while wrapped keeps order and indices", "[grow][index]") {
+    Deque<int> d;
+    makeWrapped(d);
+    REQUIRE(d.capacity() == 8);
+    d.pushFront(5);
+    d.pushFront(4);
+    d.pushBack(12);                     // Full: grows to 16
+    REQUIRE(d.capacity() == 16);
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        REQUIRE(d[i] == static_cast<int>(i) + 4);
+    }
+    d[0] = 40;
+    REQUIRE(d.front() == 40);
+}
+
+TEST_CASE("push of an element of the deque itself", "[push][alias]") {
+    Deque<std::string> d;
+    d.pushBack("a");
+    for (int i = 0; i < 20; ++i) {
+        d.pushBack(d.front());
+        d.pushFront(d.back());
+    }
+    REQUIRE(d.size() == 41);
+    REQUIRE(d[20] == "a");
+}
+
+// -----------------------------------------------------------------------------
+// Bulk operations
+// -----------------------------------------------------------------------------
+TEST_CASE("pushBackN copies across the end of the buffer", "[bulk]") {
+    Deque<int> d;
+    makeWrapped(d);
+    d.popBack();
+    d.popBack();                        // Deque: 6..9, free slots 2..5
+
+    int more[] = {10, 11, 12, 13};
+    d.pushBackN(more, 4);               // Fits without growing
+    REQUIRE(d.capacity() == 8);
+    d.pushBackN(more, 0);
+
+    int evenMore[] = {14, 15, 16};
+    d.pushBackN(evenMore, 3);           // Grows first
+    REQUIRE(d.size() == 11);
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        REQUIRE(d[i] == static_cast<int>(i) + 6);
+    }
+}
+
+TEST_CASE("popFrontN moves the oldest elements out in order", "[bulk]") {
+    Deque<int> d;
+    makeWrapped(d);
+
+    int out[4] = {};
+    REQUIRE(d.popFrontN(out, 4) == 4); // Crosses the end of the buffer
+    REQUIRE(out[0] == 6);
+    REQUIRE(out[3] == 9);
+    REQUIRE(d.front() == 10);
+
+    REQUIRE(d.popFrontN(out, 4) == 2);
+    REQUIRE(out[1] == 11);
+    REQUIRE(d.empty());
+    REQUIRE(d.popFrontN(out, 4) == 0);
+}
+
+TEST_CASE("A sliding window evicts in bulk and reads by index", "[bulk][index]") {
+    constexpr std::size_t kWindow = 100;
+    Deque<long> window;
+    std::vector<long> samples;
+    for (long i = 0; i < 5000; ++i) {
+        samples.push_back(i * 7 % 31);
+    }
+
+    for (std::size_t at = 0; at + 10 <= samples.size(); at += 10) {
+        window.pushBackN(samples.data() + at, 10);
+        if (window.size() > kWindow) {
+            REQUIRE(window.popFrontN(window.size() - kWindow) == 10);
+        }
+        long sum = 0;
+        for (std::size_t i = 0; i < window.size(); ++i) {
+            sum += window[i];
+        }
+        long expected = 0;
+        std::size_t end = at + 10;
+        std::size_t begin = end > kWindow ? end - kWindow : 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            expected += samples[i];
+        }
+        REQUIRE(sum == expected);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Copy, move and exceptions
+// -----------------------------------------------------------------------------
+TEST_CASE("Copy and move preserve a wrapped deque", "[copy][move]") {
+    Deque<int> d;
+    makeWrapped(d);
+
+    Deque<int> copy = d;
+    Deque<int> moved = std::move(d);
+    REQUIRE(d.empty());
+    Deque<int> assigned;
+    assigned = copy;
+    for (std::size_t i = 0; i < 6; ++i) {
+        REQUIRE(copy[i] == static_cast<int>(i) + 6);
+        REQUIRE(moved[i] == static_cast<int>(i) + 6);
+        REQUIRE(assigned[i] == static_cast<int>(i) + 6);
+    }
+    copy.clear();
+    REQUIRE(copy.empty());
+    copy.pushFront(1);
+    REQUIRE(copy.back() == 1);
+}
+
+TEST_CASE("A throwing pushBackN leaves the deque unchanged", "[bulk][exception]") {
+    Deque<Throwing> d;
+    Throwing::budget = 1000;
+    for (int i = 0; i < 6; ++i) {
+        d.pushBack(Throwing(i));
+    }
+    d.popFront();
+    d.popFront();                       // Next free slot is 6: the batch wraps
+
+    std::vector<Throwing> batch;
+    for (int i = 10; i < 14; ++i) {
+        batch.emplace_back(i);
+    }
+    Throwing::budget = 3;
+    REQUIRE_THROWS_AS(d.pushBackN(batch.data(), 4), std::runtime_error);
+    REQUIRE(d.size() == 4);
+    REQUIRE(d.back().value == 5);
+
+    Throwing::budget = 1000;
+    d.pushBackN(batch.data(), 4);
+    REQUIRE(d.size() == 8);
+    REQUIRE(d[7].value == 13);
+}
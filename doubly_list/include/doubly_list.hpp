@@ -4,10 +4,15 @@
 #include <cassert>
 #include <utility>
 
+#include "node_pool.hpp"
+
 namespace ds
 {
 
 // DoublyList: A circular doubly linked list with a sentinel head node
+//
+// Element nodes come from a per-list NodePool, so erased nodes are reused by
+// later inserts instead of going back to the allocator.
 template <typename T>
 class DoublyList{
 public:
@@ -67,6 +72,15 @@ public:
 
     void clear();
 
+    // Node cache: freed nodes are kept for reuse. Once more than
+    // highWaterMark() nodes are unused, a slab is given back as soon as all
+    // of its nodes are free; partly used slabs keep their free nodes, so the
+    // unused count can stay above the mark. trim() gives every completely
+    // unused slab back to the system.
+    void trim() noexcept;
+    size_type highWaterMark() const noexcept;
+    void setHighWaterMark(size_type nodes) noexcept;
+
 private:
     void swap(DoublyList& other) noexcept;
 
@@ -80,6 +94,7 @@ private:
 private:
     size_type size_ = 0;
     Node* head_ = nullptr;  // Sentinel (dummy) head
+    NodePool<Node> pool_;   // Storage for every node but the sentinel
 };
 
 template <typename T>
@@ -103,10 +118,17 @@ DoublyList<T>::DoublyList(const DoublyList<T>& other)
     // head_->next = head_;
     // head_->prev = head_;
 
-    Node* curr = other.head_->next;
-    while (curr != other.head_) {
-        pushBack(curr->data);
-        curr = curr->next;
+    // A throwing copy must hand every node back before pool_ is destroyed
+    try {
+        Node* curr = other.head_->next;
+        while (curr != other.head_) {
+            pushBack(curr->data);
+            curr = curr->next;
+        }
+    } catch (...) {
+        clear();
+        delete head_;
+        throw;
     }
 }
 
@@ -119,7 +141,7 @@ DoublyList<T>& DoublyList<T>::operator=(DoublyList<T> other) noexcept {
 
 template <typename T>
 DoublyList<T>::DoublyList(DoublyList<T>&& other) noexcept
-    : size_(other.size_), head_(other.head_) {
+    : size_(other.size_), head_(other.head_), pool_(std::move(other.pool_)) {
     other.head_ = nullptr;
     other.size_ = 0;
 }
@@ -208,17 +230,40 @@ void DoublyList<T>::clear() {
     }
 }
 
+template <typename T>
+void DoublyList<T>::trim() noexcept {
+    pool_.trim();
+}
+
+template <typename T>
+typename DoublyList<T>::size_type DoublyList<T>::highWaterMark() const noexcept {
+    return pool_.highWaterMark();
+}
+
+template <typename T>
+void DoublyList<T>::setHighWaterMark(size_type nodes) noexcept {
+    pool_.setHighWaterMark(nodes);
+}
+
 template <typename T>
 void DoublyList<T>::swap(DoublyList<T>& other) noexcept {
     using std::swap;
     swap(head_, other.head_);
     swap(size_, other.size_);
+    pool_.swap(other.pool_);
 }
 
 template <typename T>
 template <class U>
 typename DoublyList<T>::Node* DoublyList<T>::insertAfterNode(typename DoublyList<T>::Node* pos, U&& value) {
-    Node* newNode = new Node(std::forward<U>(value));
+    void* storage = pool_.allocate();
+    Node* newNode = nullptr;
+    try {
+        newNode = ::new (storage) Node(std::forward<U>(value));
+    } catch (...) {
+        pool_.deallocate(storage);
+        throw;
+    }
     newNode->next = pos->next;
     newNode->prev = pos;
     pos->next->prev = newNode;
@@ -231,7 +276,8 @@ template <typename T>
 void DoublyList<T>::eraseNode(Node* pos) noexcept {
     pos->prev->next = pos->next;
     pos->next->prev = pos->prev;
-    delete pos;
+    pos->~Node();
+    pool_.deallocate(pos);
     --size_;
 }
 
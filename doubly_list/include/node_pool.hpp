@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace ds
+{
+
+// NodePool: a cache of storage for Node objects, carved from slabs.
+//
+// A slab is one aligned block holding a header and many node slots. Since
+// slabs are aligned to their own size, a node's slab is found by masking its
+// address. Each slab keeps its own free list and counts its live nodes, so a
+// slab whose nodes have all been released is known at once and can be
+// returned to the system without touching any other slab.
+//
+// Released nodes stay cached for reuse until the pool holds more than
+// highWaterMark() idle slots; then a slab that becomes completely free is
+// released. trim() releases every completely free slab. With a stable
+// number of live nodes, allocate and deallocate call no allocator at all.
+//
+// A pool belongs to one container and is not thread-safe.
+template <class Node>
+class NodePool{
+public:
+    using size_type = std::size_t;
+
+    NodePool() noexcept = default;
+    ~NodePool();
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept;
+    NodePool& operator=(NodePool&& other) noexcept;
+
+    // Uninitialized storage for one Node
+    void* allocate();
+
+    // Takes back storage from allocate(); the Node must already be destroyed
+    void deallocate(void* p) noexcept;
+
+    // Releases every slab none of whose slots are in use
+    void trim() noexcept;
+
+    // Idle slots kept before free slabs are released; defaults to two slabs
+    size_type highWaterMark() const noexcept;
+    void setHighWaterMark(size_type slots) noexcept;
+
+    size_type liveNodes() const noexcept;
+    size_type idleSlots() const noexcept;
+    size_type slabCount() const noexcept;
+
+    // Slabs ever requested from the allocator; constant under steady churn
+    size_type slabsAllocated() const noexcept;
+
+    static constexpr size_type slotsPerSlab() noexcept { return kSlotsPerSlab; }
+
+    void swap(NodePool& other) noexcept;
+
+private:
+    union Slot {
+        Slot* next;                             // while on a free list
+        alignas(Node) unsigned char bytes[sizeof(Node)];
+    };
+
+    struct Slab {
+        Slab* prev = nullptr;                   // in the list of slabs with free slots
+        Slab* next = nullptr;
+        Slot* free = nullptr;                   // released slots
+        size_type carved = 0;                   // slots handed out at least once
+        size_type live = 0;
+    };
+
+    static constexpr size_type roundUp(size_type n, size_type to) noexcept {
+        return (n + to - 1) / to * to;
+    }
+
+    static constexpr size_type powerOfTwoAtLeast(size_type n) noexcept {
+        size_type p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static constexpr size_type kMinSlotsPerSlab = 64;
+    static constexpr size_type kSlotOffset = roundUp(sizeof(Slab), alignof(Slot));
+    static constexpr size_type kSlabBytes = powerOfTwoAtLeast(
+        kSlotOffset + kMinSlotsPerSlab * sizeof(Slot) > 4096
+            ? kSlotOffset + kMinSlotsPerSlab * sizeof(Slot)
+            : 4096);
+    static constexpr size_type kSlotsPerSlab = (kSlabBytes - kSlotOffset) / sizeof(Slot);
+
+    static Slot* slots(Slab* slab) noexcept {
+        return reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(slab) + kSlotOffset);
+    }
+
+    static Slab* slabOf(void* p) noexcept {
+        return reinterpret_cast<Slab*>(reinterpret_cast<std::uintptr_t>(p) & ~(kSlabBytes - 1));
+    }
+
+    bool full(const Slab* slab) const noexcept {
+        return slab->free == nullptr && slab->carved == kSlotsPerSlab;
+    }
+
+    void link(Slab* slab) noexcept;
+    void unlink(Slab* slab) noexcept;
+    void release(Slab* slab) noexcept;
+
+private:
+    Slab* available_ = nullptr;                 // slabs with at least one free slot
+    size_type slabs_ = 0;
+    size_type slabsAllocated_ = 0;
+    size_type live_ = 0;
+    size_type highWater_ = 2 * kSlotsPerSlab;
+};
+
+template <class Node>
+NodePool<Node>::~NodePool() {
+    assert(live_ == 0 && "Nodes still allocated from a destroyed pool");
+    trim();
+}
+
+template <class Node>
+NodePool<Node>::NodePool(NodePool&& other) noexcept
+    : available_(other.available_), slabs_(other.slabs_), slabsAllocated_(other.slabsAllocated_),
+      live_(other.live_), highWater_(other.highWater_) {
+    other.available_ = nullptr;
+    other.slabs_ = 0;
+    other.slabsAllocated_ = 0;
+    other.live_ = 0;
+}
+
+template <class Node>
+NodePool<Node>& NodePool<Node>::operator=(NodePool&& other) noexcept {
+    NodePool moved(std::move(other));
+    swap(moved);
+    return *this;
+}
+
+// Serves from the first slab with a free slot: a released slot first, then
+// one never used before
+template <class Node>
+void* NodePool<Node>::allocate() {
+    Slab* slab = available_;
+    if (slab == nullptr) {
+        slab = ::new (::operator new(kSlabBytes, std::align_val_t(kSlabBytes))) Slab();
+        ++slabs_;
+        ++slabsAllocated_;
+        link(slab);
+    }
+
+    Slot* slot = slab->free;
+    if (slot != nullptr) {
+        slab->free = slot->next;
+    } else {
+        slot = slots(slab) + slab->carved;
+        ++slab->carved;
+    }
+    ++slab->live;
+    ++live_;
+    if (full(slab)) {
+        unlink(slab);
+    }
+    return slot;
+}
+
+template <class Node>
+void NodePool<Node>::deallocate(void* p) noexcept {
+    Slab* slab = slabOf(p);
+    if (full(slab)) {
+        link(slab);
+    }
+    Slot* slot = static_cast<Slot*>(p);
+    slot->next = slab->free;
+    slab->free = slot;
+    --slab->live;
+    --live_;
+
+    if (slab->live == 0 && idleSlots() > highWater_) {
+        unlink(slab);
+        release(slab);
+    }
+}
+
+template <class Node>
+void NodePool<Node>::trim() noexcept {
+    Slab* slab = available_;
+    while (slab != nullptr) {
+        Slab* next = slab->next;
+        if (slab->live == 0) {
+            unlink(slab);
+            release(slab);
+        }
+        slab = next;
+    }
+}
+
+template <class Node>
+typename NodePool<Node>::size_type NodePool<Node>::highWaterMark() const noexcept {
+    return highWater_;
+}
+
+template <class Node>
+void NodePool<Node>::setHighWaterMark(size_type slots) noexcept {
+    highWater_ = slots;
+}
+
+template <class Node>
+typename NodePool<Node>::size_type NodePool<Node>::liveNodes() const noexcept {
+    return live_;
+}
+
+template <class Node>
+typename NodePool<Node>::size_type NodePool<Node>::idleSlots() const noexcept {
+    return slabs_ * kSlotsPerSlab - live_;
+}
+
+template <class Node>
+typename NodePool<Node>::size_type NodePool<Node>::slabCount() const noexcept {
+    return slabs_;
+}
+
+template <class Node>
+typename NodePool<Node>::size_type NodePool<Node>::slabsAllocated() const noexcept {
+    return slabsAllocated_;
+}
+
+template <class Node>
+void NodePool<Node>::swap(NodePool& other) noexcept {
+    using std::swap;
+    swap(available_, other.available_);
+    swap(slabs_, other.slabs_);
+    swap(slabsAllocated_, other.slabsAllocated_);
+    swap(live_, other.live_);
+    swap(highWater_, other.highWater_);
+}
+
+template <class Node>
+void NodePool<Node>::link(Slab* slab) noexcept {
+    slab->prev = nullptr;
+    slab->next = available_;
+    if (available_ != nullptr) {
+        available_->prev = slab;
+    }
+    available_ = slab;
+}
+
+template <class Node>
+void NodePool<Node>::unlink(Slab* slab) noexcept {
+    if (slab->prev != nullptr) {
+        slab->prev->next = slab->next;
+    } else {
+        available_ = slab->next;
+    }
+    if (slab->next != nullptr) {
+        slab->next->prev = slab->prev;
+    }
+    slab->prev = nullptr;
+    slab->next = nullptr;
+}
+
+template <class Node>
+void NodePool<Node>::release(Slab* slab) noexcept {
+    slab->~Slab();
+    ::operator delete(static_cast<void*>(slab), kSlabBytes, std::align_val_t(kSlabBytes));
+    --slabs_;
+}
+
+}
@@ -0,0 +1,162 @@
+// test_node_pool.cpp
+// Catch2 unit tests for template class NodePool<Node> and the node cache of
+// DoublyList<T> built on it.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "doubly_list.hpp"
+#include "node_pool.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ds::DoublyList;
+using ds::NodePool;
+
+namespace {
+
+struct Node {
+    Node* prev;
+    Node* next;
+    long value;
+};
+
+struct Throwing {
+    static int budget;                  // Copies allowed before one throws
+    int value = 0;
+
+    Throwing() = default;               // For the list's sentinel
+    explicit Throwing(int v) : value(v) {}
+    Throwing(const Throwing& other) : value(other.value) {
+        if (--budget < 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    bool operator==(const Throwing& other) const { return value == other.value; }
+};
+
+int Throwing::budget = 0;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// NodePool
+// -----------------------------------------------------------------------------
+TEST_CASE("NodePool carves slots from slabs and reuses released ones", "[pool]") {
+    NodePool<Node> pool;
+    REQUIRE(pool.slabCount() == 0);
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    REQUIRE(a != b);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(a) % alignof(Node) == 0);
+    REQUIRE(pool.slabCount() == 1);
+    REQUIRE(pool.liveNodes() == 2);
+
+    pool.deallocate(a);
+    REQUIRE(pool.allocate() == a);      // Most recently released first
+
+    std::vector<void*> nodes{a, b};
+    while (nodes.size() <= NodePool<Node>::slotsPerSlab()) {
+        nodes.push_back(pool.allocate());
+    }
+    REQUIRE(pool.slabCount() == 2);
+
+    for (void* p : nodes) {
+        pool.deallocate(p);
+    }
+    REQUIRE(pool.liveNodes() == 0);
+    REQUIRE(pool.slabCount() == 2);     // Within the high-water mark: cached
+
+    pool.trim();
+    REQUIRE(pool.slabCount() == 0);
+    REQUIRE(pool.idleSlots() == 0);
+}
+
+TEST_CASE("NodePool releases free slabs beyond the high-water mark", "[pool][highwater]") {
+    NodePool<Node> pool;
+    pool.setHighWaterMark(NodePool<Node>::slotsPerSlab());
+    REQUIRE(pool.highWaterMark() == NodePool<Node>::slotsPerSlab());
+
+    std::vector<void*> nodes;
+    for (std::size_t i = 0; i < 4 * NodePool<Node>::slotsPerSlab(); ++i) {
+        nodes.push_back(pool.allocate());
+    }
+    REQUIRE(pool.slabCount() == 4);
+
+    for (void* p : nodes) {
+        pool.deallocate(p);
+    }
+    REQUIRE(pool.slabCount() == 1);     // Only as many idle slots as allowed
+    REQUIRE(pool.idleSlots() <= NodePool<Node>::slotsPerSlab());
+}
+
+TEST_CASE("steady churn allocates no slabs", "[pool][churn]") {
+    NodePool<Node> pool;
+    std::vector<void*> fifo;            // Used as a queue of stable length
+    for (int i = 0; i < 1000; ++i) {
+        fifo.push_back(pool.allocate());
+    }
+    std::size_t before = pool.slabsAllocated();
+
+    std::size_t front = 0;
+    for (int i = 0; i < 100000; ++i) {
+        pool.deallocate(fifo[front]);
+        fifo[front] = pool.allocate();
+        front = (front + 1) % fifo.size();
+    }
+    REQUIRE(pool.slabsAllocated() == before);
+    REQUIRE(pool.liveNodes() == 1000);
+
+    for (void* p : fifo) {
+        pool.deallocate(p);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// DoublyList node cache
+// -----------------------------------------------------------------------------
+TEST_CASE("DoublyList reuses nodes across churn and trim", "[list][churn][trim]") {
+    DoublyList<std::string> list;
+    list.setHighWaterMark(1000000);
+    REQUIRE(list.highWaterMark() == 1000000);
+    for (int i = 0; i < 5000; ++i) {
+        list.pushBack(std::to_string(i));
+    }
+    for (int i = 0; i < 20000; ++i) {
+        list.popFront();
+        list.pushBack(std::to_string(i));
+    }
+    for (int i = 0; i < 100; ++i) {     // Insert and erase in the middle
+        REQUIRE(list.insertAfter(std::to_string(19000 + i), "x"));
+        REQUIRE(list.erase("x"));
+    }
+    REQUIRE(list.size() == 5000);
+    REQUIRE(list.contains("19999"));
+
+    list.clear();
+    list.trim();
+    list.pushBack("fresh");
+    REQUIRE(list.contains("fresh"));
+
+    DoublyList<std::string> copy = list;
+    DoublyList<std::string> moved = std::move(list);
+    REQUIRE(moved.size() == 1);
+    REQUIRE(copy.contains("fresh"));
+}
+
+TEST_CASE("A throwing copy hands its nodes back to the pool", "[list][copy][exception]") {
+    using ThrowingList = DoublyList<Throwing>;
+    Throwing::budget = 1000;
+    ThrowingList list;
+    for (int i = 0; i < 5; ++i) {
+        list.pushBack(Throwing(i));
+    }
+
+    Throwing::budget = 2;               // The third copy throws
+    REQUIRE_THROWS_AS(ThrowingList(list), std::runtime_error);
+    REQUIRE(list.size() == 5);
+}
\ No newline at end of file
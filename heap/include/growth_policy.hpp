@@ -0,0 +1,293 @@
+#pragma once
+
+// The seq_list, stack and heap modules each carry an identical copy of this
+// header so that every module still builds on its own. The named guard lets
+// two of the copies meet in one translation unit.
+#ifndef DS_GROWTH_POLICY_HPP
+#define DS_GROWTH_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define DS_GROWTH_MMAP 1
+#endif
+
+namespace ds {
+
+// is_trivially_relocatable: a type whose objects can be moved to another
+// address with a plain memcpy, leaving nothing behind to destroy.
+// Trivially copyable types qualify by default; specialize it for other types
+// that are safe to relocate bitwise.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Growth policies decide how far a container's buffer grows and where its
+// memory comes from. A policy is a class with these static members:
+//
+//   template <class T> size_type nextCapacity(size_type capacity, size_type required)
+//       the capacity to grow to, at least `required`; capacity is 0 for a
+//       buffer that does not exist yet
+//   template <class T> T* allocate(size_type capacity)
+//       uninitialized storage for capacity elements
+//   template <class T> T* reallocate(T* data, size_type capacity, size_type newCapacity)
+//       moves the buffer's bytes to storage for newCapacity elements; used
+//       only for trivially relocatable T
+//   template <class T> void deallocate(T* data, size_type capacity) noexcept
+//
+// allocate and reallocate throw std::bad_alloc, leaving the old buffer as
+// it was.
+
+namespace detail {
+
+inline std::size_t checkedBytes(std::size_t count, std::size_t size) {
+    if (count > static_cast<std::size_t>(-1) / size) {
+        throw std::bad_alloc();
+    }
+    return count * size;
+}
+
+} // namespace detail
+
+// MallocStorage: buffers from malloc. realloc either extends a block in
+// place or does the memcpy for us.
+struct MallocStorage {
+    template <class T>
+    static T* allocate(std::size_t capacity) {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "over-aligned element types are not supported");
+        void* p = std::malloc(detail::checkedBytes(capacity, sizeof(T)));
+        if (p == nullptr && capacity != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    template <class T>
+    static T* reallocate(T* data, std::size_t, std::size_t newCapacity) {
+        void* p = std::realloc(data, detail::checkedBytes(newCapacity, sizeof(T)));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    template <class T>
+    static void deallocate(T* data, std::size_t) noexcept {
+        std::free(data);
+    }
+};
+
+// GeometricGrowth: multiplies the capacity by Num / Den
+template <std::size_t Num = 2, std::size_t Den = 1>
+struct GeometricGrowth : MallocStorage {
+    static_assert(Den > 0 && Num > Den, "the growth factor must be greater than 1");
+
+    static constexpr std::size_t kInitialCapacity = 4;
+
+    template <class T>
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t required) noexcept {
+        std::size_t next = kInitialCapacity;
+        if (capacity != 0) {
+            next = capacity > static_cast<std::size_t>(-1) / Num
+                 ? static_cast<std::size_t>(-1)
+                 : capacity * Num / Den;
+        }
+        if (next <= capacity) {
+            next = capacity + 1;
+        }
+        return next < required ? required : next;
+    }
+};
+
+// FixedStepGrowth: adds Step slots each time. Memory overhead stays below
+// Step elements, at the price of O(n / Step) reallocations.
+template <std::size_t Step>
+struct FixedStepGrowth : MallocStorage {
+    static_assert(Step > 0, "the growth step must be positive");
+
+    template <class T>
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t required) noexcept {
+        std::size_t next = capacity > static_cast<std::size_t>(-1) - Step
+                         ? static_cast<std::size_t>(-1)
+                         : capacity + Step;
+        return next < required ? required : next;
+    }
+};
+
+// PageRoundedGrowth: grows as Base does, then rounds up so the buffer fills
+// whole pages; the slack the allocator would waste becomes capacity
+template <class Base = GeometricGrowth<>, std::size_t PageSize = 4096>
+struct PageRoundedGrowth : Base {
+    static_assert((PageSize & (PageSize - 1)) == 0, "the page size must be a power of two");
+
+    template <class T>
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t required) noexcept {
+        std::size_t next = Base::template nextCapacity<T>(capacity, required);
+        if (next > (static_cast<std::size_t>(-1) - PageSize) / sizeof(T)) {
+            return next;
+        }
+        std::size_t bytes = (next * sizeof(T) + PageSize - 1) & ~(PageSize - 1);
+        return bytes / sizeof(T);
+    }
+};
+
+// MappedGrowth: buffers of kMapThreshold bytes and up are anonymous memory
+// mappings. Growing one remaps its pages (mremap on Linux) rather than
+// copying its bytes, so a multi-gigabyte buffer grows in about the time it
+// takes to update the page tables. With HugePages, mappings of 2 MiB and up
+// start on a 2 MiB boundary and are advised MADV_HUGEPAGE. Smaller buffers
+// come from malloc. Capacities are page rounded so mappings are used whole.
+//
+// Only trivially relocatable elements take the remap path; other types are
+// still moved element by element into a fresh buffer.
+template <class Base = GeometricGrowth<>, bool HugePages = true>
+struct MappedGrowth {
+    static constexpr std::size_t kPageSize = 4096;
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+    static constexpr std::size_t kMapThreshold = std::size_t{1} << 20;
+
+    template <class T>
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t required) noexcept {
+        return PageRoundedGrowth<Base, kPageSize>::template nextCapacity<T>(capacity, required);
+    }
+
+    template <class T>
+    static T* allocate(std::size_t capacity) {
+        std::size_t bytes = detail::checkedBytes(capacity, sizeof(T));
+        if (!isMapped(bytes)) {
+            return MallocStorage::allocate<T>(capacity);
+        }
+        return static_cast<T*>(map(bytes));
+    }
+
+    template <class T>
+    static T* reallocate(T* data, std::size_t capacity, std::size_t newCapacity) {
+        std::size_t oldBytes = capacity * sizeof(T);
+        std::size_t newBytes = detail::checkedBytes(newCapacity, sizeof(T));
+        if (!isMapped(oldBytes) && !isMapped(newBytes)) {
+            return MallocStorage::reallocate(data, capacity, newCapacity);
+        }
+        if (isMapped(oldBytes) && isMapped(newBytes)) {
+            return static_cast<T*>(remap(data, oldBytes, newBytes));
+        }
+
+        // Crossing the threshold copies once
+        T* fresh = allocate<T>(newCapacity);
+        if (capacity != 0) {
+            std::memcpy(static_cast<void*>(fresh), data, oldBytes < newBytes ? oldBytes : newBytes);
+        }
+        deallocate(data, capacity);
+        return fresh;
+    }
+
+    template <class T>
+    static void deallocate(T* data, std::size_t capacity) noexcept {
+        std::size_t bytes = capacity * sizeof(T);
+        if (!isMapped(bytes)) {
+            MallocStorage::deallocate(data, capacity);
+            return;
+        }
+        unmap(data, bytes);
+    }
+
+private:
+    static bool isMapped(std::size_t bytes) noexcept {
+#if defined(DS_GROWTH_MMAP)
+        return bytes >= kMapThreshold;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    static std::size_t pageRounded(std::size_t bytes) noexcept {
+        return (bytes + kPageSize - 1) & ~(kPageSize - 1);
+    }
+
+#if defined(DS_GROWTH_MMAP)
+    static void* map(std::size_t bytes) {
+        std::size_t length = pageRounded(bytes);
+        if (!HugePages || length < kHugePageSize) {
+            void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        // Over-map by one huge page, then trim both ends to a huge page boundary
+        std::size_t padded = length + kHugePageSize;
+        void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+        std::uintptr_t aligned = (start + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        std::size_t head = aligned - start;
+        std::size_t tail = padded - head - length;
+        if (head != 0) {
+            ::munmap(raw, head);
+        }
+        if (tail != 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+
+        void* p = reinterpret_cast<void*>(aligned);
+        adviseHugePages(p, length);
+        return p;
+    }
+
+    static void* remap(void* data, std::size_t oldBytes, std::size_t newBytes) {
+        std::size_t oldLength = pageRounded(oldBytes);
+        std::size_t newLength = pageRounded(newBytes);
+#if defined(__linux__)
+        void* p = ::mremap(data, oldLength, newLength, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        adviseHugePages(p, newLength);
+        return p;
+#else
+        void* p = map(newBytes);
+        std::memcpy(p, data, oldLength < newLength ? oldLength : newLength);
+        ::munmap(data, oldLength);
+        return p;
+#endif
+    }
+
+    static void unmap(void* data, std::size_t bytes) noexcept {
+        ::munmap(data, pageRounded(bytes));
+    }
+
+    // Advice only: a kernel without transparent huge pages just ignores it
+    static void adviseHugePages(void* p, std::size_t length) noexcept {
+#if defined(MADV_HUGEPAGE)
+        if (HugePages && length >= kHugePageSize) {
+            ::madvise(p, length, MADV_HUGEPAGE);
+        }
+#else
+        (void)p;
+        (void)length;
+#endif
+    }
+#else
+    static void* map(std::size_t) { throw std::bad_alloc(); }
+    static void* remap(void*, std::size_t, std::size_t) { throw std::bad_alloc(); }
+    static void unmap(void*, std::size_t) noexcept {}
+#endif
+};
+
+}
+
+#endif
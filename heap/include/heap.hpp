@@ -2,9 +2,14 @@
 
 #include <cstddef>
 #include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <initializer_list>
 
+#include "growth_policy.hpp"
+
 namespace ds {
 
 template<typename T>
@@ -21,7 +26,9 @@ struct Greater {
     }
 };
 
-template<typename T, typename Compare = Less<T>>
+// Growth is the growth policy (growth_policy.hpp); the default keeps the
+// heap's 4x growth factor.
+template<typename T, typename Compare = Less<T>, class Growth = GeometricGrowth<4>>
 class Heap {
 public: 
     using size_type = std::size_t;
@@ -48,6 +55,7 @@ public:
 
 private:
     void ensureCapacity();
+    void reallocate(size_type newCapacity);
 
     void swap(Heap& other) noexcept;
 
@@ -58,64 +66,64 @@ private:
 private:
     size_type size_ = 0;
     size_type capacity_ = 0;
-    T* data_ = nullptr;
+    T* data_ = nullptr;         // uninitialized storage, [0, size_) is constructed
     Compare comp_{};
-
-    static constexpr size_type kInitialCapacity = 4;
 };
 
-template<typename T, typename Compare>
-Heap<T, Compare>::Heap(Compare comp) 
+template<typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>::Heap(Compare comp) 
     : size_(0), 
-      capacity_(kInitialCapacity), 
-      data_(new T[kInitialCapacity]), 
+      capacity_(Growth::template nextCapacity<T>(0, 1)), 
+      data_(Growth::template allocate<T>(capacity_)), 
       comp_(std::move(comp)) 
 {}
 
-template<typename T, typename Compare>
-Heap<T, Compare>::Heap(const T* ptr, size_type n, Compare comp)
-    : size_(n), 
-      capacity_(n > kInitialCapacity ? n : kInitialCapacity), 
-      data_(new T[capacity_]),
+template<typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>::Heap(const T* ptr, size_type n, Compare comp)
+    : size_(0), 
+      capacity_(Growth::template nextCapacity<T>(0, n)), 
+      data_(Growth::template allocate<T>(capacity_)),
       comp_(std::move(comp)) {
-    for (size_type i = 0; i < n; ++i) {
-        data_[i] = ptr[i];
+    try {
+        std::uninitialized_copy(ptr, ptr + n, data_);
+    } catch (...) {
+        Growth::template deallocate<T>(data_, capacity_);
+        throw;
     }
+    size_ = n;
     buildHeap(); // O(n) bottom-up heapify
 }
 
-template <typename T, typename Compare>
-Heap<T, Compare>::Heap(std::initializer_list<T> init, Compare comp)
-    : size_(static_cast<size_type>(init.size())),
-      capacity_(size_ > kInitialCapacity ? size_ : kInitialCapacity),
-      data_(new T[capacity_]),
-      comp_(std::move(comp)) {
-    size_type i = 0;
-    for (const auto& x : init) data_[i++] = x;
-    buildHeap(); // O(n)
-}
+template <typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>::Heap(std::initializer_list<T> init, Compare comp)
+    : Heap(init.begin(), static_cast<size_type>(init.size()), std::move(comp)) {}
 
-template <typename T, typename Compare>
-Heap<T, Compare>::~Heap() {
-    delete[] data_;
+template <typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>::~Heap() {
+    std::destroy(data_, data_ + size_);
+    Growth::template deallocate<T>(data_, capacity_);
     data_ = nullptr;
     size_ = 0;
     capacity_ = 0;
 }
 
-template <typename T, typename Compare>
-Heap<T, Compare>::Heap(const Heap& other)
-    : size_(other.size_),
+template <typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>::Heap(const Heap& other)
+    : size_(0),
       capacity_(other.capacity_),
-      data_(new T[capacity_]),
+      data_(Growth::template allocate<T>(capacity_)),
       comp_(other.comp_){
-    for (size_type i = 0; i < size_; ++i) {
-        data_[i] = other.data_[i];
+    try {
+        std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+    } catch (...) {
+        Growth::template deallocate<T>(data_, capacity_);
+        throw;
     }
+    size_ = other.size_;
 }
 
-template <typename T, typename Compare>
-Heap<T, Compare>::Heap(Heap&& other) noexcept
+template <typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>::Heap(Heap&& other) noexcept
     : size_(other.size_), 
       capacity_(other.capacity_),
       data_(other.data_),
@@ -125,70 +133,99 @@ Heap<T, Compare>::Heap(Heap&& other) noexcept
     other.data_ = nullptr;
 }
 
-template <typename T, typename Compare>
-Heap<T, Compare>& Heap<T, Compare>::operator=(Heap other) noexcept {
+template <typename T, typename Compare, class Growth>
+Heap<T, Compare, Growth>& Heap<T, Compare, Growth>::operator=(Heap other) noexcept {
     swap(other);
     return *this;
 }
 
-template<typename T, typename Compare>
-const T& Heap<T, Compare>::top() const {
+template<typename T, typename Compare, class Growth>
+const T& Heap<T, Compare, Growth>::top() const {
     assert(size_ > 0 && "Heap is empty");
     return data_[0];
 }
 
-template<typename T, typename Compare>
+template<typename T, typename Compare, class Growth>
 template<class U>
-void Heap<T, Compare>::push(U&& value) {
-    ensureCapacity();
-    data_[size_] = std::forward<U>(value);
+void Heap<T, Compare, Growth>::push(U&& value) {
+    if (size_ < capacity_) {
+        ::new (static_cast<void*>(data_ + size_)) T(std::forward<U>(value));
+    } else {
+        // value may be top() itself, so materialize it before growth moves it
+        T tmp(std::forward<U>(value));
+        ensureCapacity();
+        ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
+    }
     siftUp(size_);
     ++size_;
 }
 
-template<typename T, typename Compare>
-void Heap<T, Compare>::pop() {
+template<typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::pop() {
     assert(size_ > 0 && "Heap is empty");
     std::swap(data_[0], data_[size_ - 1]);
     --size_;
+    std::destroy_at(data_ + size_);
     if (size_ > 0) {
         siftDown(0);
     }
 }
 
-template<typename T, typename Compare>
-void Heap<T, Compare>::clear() noexcept {
+template<typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::clear() noexcept {
+    std::destroy(data_, data_ + size_);
     size_ = 0;
 }
 
-template<typename T, typename Compare>
-bool Heap<T, Compare>::empty() const noexcept {
+template<typename T, typename Compare, class Growth>
+bool Heap<T, Compare, Growth>::empty() const noexcept {
     return size_ == 0;
 }
 
-template<typename T, typename Compare>
-typename Heap<T, Compare>::size_type
-Heap<T, Compare>::size() const noexcept {
+template<typename T, typename Compare, class Growth>
+typename Heap<T, Compare, Growth>::size_type
+Heap<T, Compare, Growth>::size() const noexcept {
     return size_;
 }
 
 
-template <typename T, typename Compare>
-void Heap<T, Compare>::ensureCapacity() {
+template <typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::ensureCapacity() {
     if (size_ >= capacity_) {
-        size_type newCapacity = capacity_ == 0 ? kInitialCapacity : capacity_ * 4;
-        T* newData = new T[newCapacity];
-        for (size_type i = 0; i < size_; ++i) {
-            newData[i] = data_[i];
+        reallocate(Growth::template nextCapacity<T>(capacity_, size_ + 1));
+    }
+}
+
+// Trivially relocatable elements move as bytes, through the policy
+// (realloc, mremap); others are moved one by one into a new buffer
+template <typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::reallocate(size_type newCapacity) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        data_ = Growth::template reallocate<T>(data_, capacity_, newCapacity);
+        capacity_ = newCapacity;
+    } else {
+        T* newData = Growth::template allocate<T>(newCapacity);
+        try {
+            // Fall back to copying when a throwing move could lose elements
+            if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                          !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(data_, data_ + size_, newData);
+            } else {
+                std::uninitialized_copy(data_, data_ + size_, newData);
+            }
+        } catch (...) {
+            Growth::template deallocate<T>(newData, newCapacity);
+            throw;
         }
-        delete[] data_;
+        std::destroy(data_, data_ + size_);
+        Growth::template deallocate<T>(data_, capacity_);
         data_ = newData;
         capacity_ = newCapacity;
     }
 }
 
-template <typename T, typename Compare>
-void Heap<T, Compare>::swap(Heap& other) noexcept{
+template <typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::swap(Heap& other) noexcept{
     using std::swap;
     swap(size_, other.size_);
     swap(capacity_, other.capacity_);
@@ -196,8 +233,8 @@ void Heap<T, Compare>::swap(Heap& other) noexcept{
     swap(comp_, other.comp_);
 }
 
-template <typename T, typename Compare>
-void Heap<T, Compare>::siftDown(size_type idx) {
+template <typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::siftDown(size_type idx) {
     while (true) {
         size_type left  = 2 * idx + 1;
         size_type right = 2 * idx + 2;
@@ -220,8 +257,8 @@ void Heap<T, Compare>::siftDown(size_type idx) {
     }
 }
 
-template<typename T, typename Compare>
-void Heap<T, Compare>::siftUp(size_type idx) {
+template<typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::siftUp(size_type idx) {
     while (idx > 0) {
         size_type parent = (idx - 1) / 2;
         if (comp_(data_[parent], data_[idx])) {
@@ -233,8 +270,8 @@ void Heap<T, Compare>::siftUp(size_type idx) {
     }
 }
 
-template<typename T, typename Compare>
-void Heap<T, Compare>::buildHeap() {
+template<typename T, typename Compare, class Growth>
+void Heap<T, Compare, Growth>::buildHeap() {
     if (size_ <= 1) {
         return; 
     }
@@ -246,4 +246,52 @@ TEST_CASE("Comparator with state works via constructor-injected instance", "[com
         REQUIRE((x % 5) <= lastKey);
         lastKey = x % 5;
     }
+}
+
+// -----------------------------------------------------------------------------
+// Growth policies and element lifetime
+// -----------------------------------------------------------------------------
+TEST_CASE("Heap grows through the chosen policy", "[growth][policy]") {
+    Heap<std::string, Less<std::string>, ds::GeometricGrowth<3, 2>> h;
+    for (int i = 0; i < 100; ++i) {
+        h.push(std::to_string(1000 + i));
+    }
+    h.push(h.top());                // Reference into the heap across a growth
+    REQUIRE(h.size() == 101);
+
+    std::string last = h.top();
+    h.pop();
+    REQUIRE(h.top() == last);       // The duplicate of the maximum
+    while (!h.empty()) {
+        REQUIRE(h.top() <= last);
+        last = h.top();
+        h.pop();
+    }
+}
+
+TEST_CASE("Heap destroys every element it constructs", "[lifetime]") {
+    static int live = 0;
+    struct Tracked {
+        int key;
+        explicit Tracked(int k) : key(k) { ++live; }
+        Tracked(const Tracked& other) : key(other.key) { ++live; }
+        Tracked& operator=(const Tracked&) = default;
+        ~Tracked() { --live; }
+        bool operator<(const Tracked& other) const { return key < other.key; }
+    };
+
+    {
+        Heap<Tracked> h;
+        for (int i = 0; i < 50; ++i) {
+            h.push(Tracked(i));
+        }
+        h.pop();
+        REQUIRE(h.top().key == 48);
+        REQUIRE(live == 49);
+
+        Heap<Tracked> copy = h;
+        copy.clear();
+        REQUIRE(live == 49);
+    }
+    REQUIRE(live == 0);
 }
\ No newline at end of file
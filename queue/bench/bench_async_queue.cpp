@@ -0,0 +1,134 @@
+// bench_async_queue.cpp
+// Handoff latency: a coroutine woken by AsyncQueue against a thread woken
+// by BlockingQueue. Each round trip sends a message to a waiting consumer
+// and waits for its reply:
+//   threads     - consumer thread blocked in BlockingQueue::pop
+//   coroutine   - consumer coroutine suspended in co_await AsyncQueue::pop,
+//                 resumed inline by the push on the same thread
+//   event loop  - the same coroutine resumed by an executor on another
+//                 thread, the reply coming back through a BlockingQueue
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "async_queue.hpp"
+#include "blocking_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+// Resumes coroutines on its own thread, one after another
+class LoopExecutor : public ds::Executor {
+public:
+    LoopExecutor() : thread_([this] { run(); }) {}
+
+    ~LoopExecutor() {
+        handles_.close();
+        thread_.join();
+    }
+
+    void execute(std::coroutine_handle<> handle) override { handles_.push(handle); }
+
+private:
+    void run() {
+        std::coroutine_handle<> handle;
+        while (handles_.pop(handle)) {
+            handle.resume();
+        }
+    }
+
+    ds::BlockingQueue<std::coroutine_handle<>> handles_;
+    std::thread thread_;
+};
+
+template <class Ping, class Pong>
+Detached echo(Ping& ping, Pong& pong) {
+    while (auto value = co_await ping.pop()) {
+        pong.push(*value);
+    }
+}
+
+void report(const char* name, std::vector<double>& nanos) {
+    std::sort(nanos.begin(), nanos.end());
+    double sum = 0;
+    for (double n : nanos) {
+        sum += n;
+    }
+    std::printf("%-12s round trip  mean %9.0f ns   p50 %9.0f ns   p99 %9.0f ns\n",
+                name, sum / nanos.size(), nanos[nanos.size() / 2], nanos[nanos.size() * 99 / 100]);
+}
+
+// Times rounds round trips of send(i) followed by receive()
+template <class Send, class Receive>
+std::vector<double> measure(int rounds, Send send, Receive receive) {
+    std::vector<double> nanos(rounds);
+    for (int i = 0; i < rounds; ++i) {
+        auto start = Clock::now();
+        send(i);
+        receive();
+        nanos[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    return nanos;
+}
+
+void threads(int rounds) {
+    ds::BlockingQueue<int> ping, pong;
+    std::thread consumer([&] {
+        int value = 0;
+        while (ping.pop(value)) {
+            pong.push(value);
+        }
+    });
+    int value = 0;
+    auto nanos = measure(rounds, [&](int i) { ping.push(i); }, [&] { pong.pop(value); });
+    ping.close();
+    consumer.join();
+    report("threads", nanos);
+}
+
+void coroutine(int rounds) {
+    ds::AsyncQueue<int> ping, pong;
+    echo(ping, pong);
+    int value = 0;
+    auto nanos = measure(rounds, [&](int i) { ping.push(i); }, [&] { pong.tryPop(value); });
+    ping.close();
+    report("coroutine", nanos);
+}
+
+void eventLoop(int rounds) {
+    LoopExecutor loop;
+    ds::AsyncQueue<int> ping(loop);
+    ds::BlockingQueue<int> pong;
+    echo(ping, pong);                   // Suspends at once on the empty queue
+    int value = 0;
+    auto nanos = measure(rounds, [&](int i) { ping.push(i); }, [&] { pong.pop(value); });
+    ping.close();                       // Ends the echo before the loop stops
+    report("event loop", nanos);
+}
+
+} // namespace
+
+int main() {
+    threads(200000);
+    coroutine(2000000);
+    eventLoop(200000);
+    return 0;
+}
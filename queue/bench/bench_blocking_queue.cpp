@@ -0,0 +1,84 @@
+// bench_blocking_queue.cpp
+// What a consumer costs while idle and how fast it reacts: BlockingQueue
+// against a consumer polling a mutex-wrapped Queue's empty() in a loop.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "blocking_queue.hpp"
+#include "queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kMessages = 2000;
+constexpr auto kGap = std::chrono::microseconds(500);   // between messages: mostly idle
+
+class PolledQueue {
+public:
+    bool push(Clock::time_point value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(value);
+        return true;
+    }
+
+    bool pop(Clock::time_point& out) {
+        for (;;) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!queue_.empty()) {
+                out = queue_.front();
+                queue_.pop();
+                return true;
+            }
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    ds::Queue<Clock::time_point> queue_;
+};
+
+// Sends timestamps with gaps; the consumer records how late each arrives
+template <class Q>
+void run(const char* name) {
+    Q q;
+    std::vector<double> latencies(kMessages);
+
+    std::clock_t cpuStart = std::clock();
+    auto wallStart = Clock::now();
+    std::thread consumer([&] {
+        Clock::time_point sent;
+        for (int i = 0; i < kMessages; ++i) {
+            q.pop(sent);
+            latencies[i] = std::chrono::duration<double, std::micro>(Clock::now() - sent).count();
+        }
+    });
+    for (int i = 0; i < kMessages; ++i) {
+        std::this_thread::sleep_for(kGap);
+        q.push(Clock::now());
+    }
+    consumer.join();
+    double wall = std::chrono::duration<double>(Clock::now() - wallStart).count();
+    double cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%-22s CPU %5.1f%% of wall time   wake-up p50 %7.1f us   p99 %7.1f us\n",
+                name, 100.0 * cpu / wall, latencies[kMessages / 2], latencies[kMessages * 99 / 100]);
+}
+
+} // namespace
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    run<PolledQueue>("polling mutex+Queue");
+    run<ds::BlockingQueue<Clock::time_point>>("BlockingQueue");
+    return 0;
+}
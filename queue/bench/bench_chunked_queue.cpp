@@ -0,0 +1,103 @@
+// bench_chunked_queue.cpp
+// Memory per element and fill/drain time of ChunkedQueue for 10M ints,
+// against a queue that allocates a node per element (std::list, as Queue
+// used to), the ring-buffer Queue and std::queue over std::deque.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "chunked_queue.hpp"
+#include "queue.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <queue>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kElements = 10000000;
+
+std::size_t liveBytes = 0;
+
+// Counts the bytes a node-based container asks for; malloc's own
+// per-allocation header is not included
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        liveBytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) noexcept {
+        liveBytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <class U>
+    bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+struct Result {
+    double fillMs;
+    double drainMs;
+    double bytesPerElement;
+};
+
+// Fills the queue, asks footprint(q) for its bytes, then drains it
+template <class Q, class Footprint>
+Result run(Footprint footprint) {
+    Q q;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < kElements; ++i) {
+        q.push(static_cast<int>(i));
+    }
+    auto filled = Clock::now();
+    double bytes = static_cast<double>(footprint(q));
+
+    std::uint64_t checksum = 0;
+    auto drainStart = Clock::now();
+    while (!q.empty()) {
+        checksum += static_cast<std::uint64_t>(q.front());
+        q.pop();
+    }
+    auto drained = Clock::now();
+    if (checksum != static_cast<std::uint64_t>(kElements) * (kElements - 1) / 2) {
+        std::printf("checksum mismatch\n");
+    }
+    return {std::chrono::duration<double, std::milli>(filled - start).count(),
+            std::chrono::duration<double, std::milli>(drained - drainStart).count(),
+            bytes / kElements};
+}
+
+void report(const char* name, const Result& r) {
+    std::printf("%-28s %6.2f B/element   fill %7.1f ms   drain %7.1f ms\n",
+                name, r.bytesPerElement, r.fillMs, r.drainMs);
+}
+
+} // namespace
+
+int main() {
+    using NodeQueue = std::queue<int, std::list<int, CountingAllocator<int>>>;
+    using DequeQueue = std::queue<int, std::deque<int, CountingAllocator<int>>>;
+
+    report("node per element", run<NodeQueue>([](const NodeQueue&) { return liveBytes; }));
+    report("std::queue (std::deque)", run<DequeQueue>([](const DequeQueue&) { return liveBytes; }));
+    report("ds::Queue", run<ds::Queue<int>>([](const ds::Queue<int>& q) {
+        return q.capacity() * sizeof(int);
+    }));
+    report("ds::ChunkedQueue", run<ds::ChunkedQueue<int>>([](const ds::ChunkedQueue<int>& q) {
+        return q.blockCount() * ds::ChunkedQueue<int>::blockBytes();
+    }));
+    return 0;
+}
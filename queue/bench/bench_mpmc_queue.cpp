@@ -0,0 +1,109 @@
+// bench_mpmc_queue.cpp
+// Throughput of MpmcQueue against a mutex-wrapped Queue, with equal numbers
+// of producer and consumer threads and payloads of several sizes.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "mpmc_queue.hpp"
+#include "queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kMessages = 4000000;
+
+template <std::size_t Bytes>
+struct Payload {
+    unsigned char bytes[Bytes];
+};
+
+template <class T>
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t) {}
+
+    bool tryPush(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(value);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        out = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    ds::Queue<T> queue_;
+};
+
+template <class Q, class T>
+double run(std::size_t pairs) {
+    Q q(1024);
+    std::atomic<std::size_t> consumed{0};
+    std::size_t perProducer = kMessages / pairs;
+    std::size_t total = perProducer * pairs;
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < pairs; ++p) {
+        threads.emplace_back([&q, perProducer] {
+            T item{};
+            for (std::size_t i = 0; i < perProducer; ++i) {
+                item.bytes[0] = static_cast<unsigned char>(i);
+                while (!q.tryPush(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&q, &consumed, total] {
+            T item;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (q.tryPop(item)) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return static_cast<double>(total) / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <std::size_t Bytes>
+void compare() {
+    using T = Payload<Bytes>;
+    for (std::size_t pairs : {1u, 2u, 4u, 8u}) {
+        double locked = run<LockedQueue<T>, T>(pairs);
+        double lockFree = run<ds::MpmcQueue<T>, T>(pairs);
+        std::printf("payload %3zu B  producers=consumers=%-2zu  mutex+Queue %7.2f M/s   MpmcQueue %7.2f M/s   x%.2f\n",
+                    Bytes, pairs, locked / 1e6, lockFree / 1e6, lockFree / locked);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    compare<8>();
+    compare<64>();
+    compare<256>();
+    return 0;
+}
@@ -0,0 +1,62 @@
+// bench_queue.cpp
+// Message-loop throughput of the ring-buffer Queue against a queue that
+// allocates a node per element (std::list, as Queue used to) and against
+// std::queue over std::deque.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "queue.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <list>
+#include <queue>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kMessages = 20000000;
+
+// Keeps `window` messages in flight: every push is matched by a pop
+template <class Q, class Make>
+double run(std::size_t window, Make make) {
+    Q q;
+    std::uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < window; ++i) {
+        q.push(make(i));
+    }
+    for (std::size_t i = window; i < kMessages; ++i) {
+        q.push(make(i));
+        checksum += sizeof(q.front());
+        q.pop();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (checksum == 0) {
+        std::printf("unreachable\n");
+    }
+    return static_cast<double>(kMessages) / seconds / 1e6;
+}
+
+template <class T, class Make>
+void compare(const char* type, std::size_t window, Make make) {
+    double nodes = run<std::queue<T, std::list<T>>>(window, make);
+    double deque = run<std::queue<T>>(window, make);
+    double ring = run<ds::Queue<T>>(window, make);
+    std::printf("%-12s window=%-7zu node-per-element %7.1f M/s   std::queue %7.1f M/s   ds::Queue %7.1f M/s   x%.1f\n",
+                type, window, nodes, deque, ring, ring / nodes);
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t window : {16u, 1024u, 65536u}) {
+        compare<std::uint64_t>("uint64_t", window, [](std::size_t i) { return static_cast<std::uint64_t>(i); });
+        compare<std::string>("string", window, [](std::size_t) { return std::string("message"); });
+    }
+    return 0;
+}
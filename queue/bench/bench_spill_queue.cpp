@@ -0,0 +1,75 @@
+// bench_spill_queue.cpp
+// A traffic burst through SpillQueue with a 32 MiB budget against the
+// in-memory Queue: peak memory of the elements and the latency of each
+// push and pop, including those that spill or load a segment.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "queue.hpp"
+#include "spill_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kBurst = 32u << 20;          // 256 MiB of uint64_t
+
+void report(const char* name, const char* op, std::vector<float>& nanos) {
+    std::sort(nanos.begin(), nanos.end());
+    auto at = [&](double q) { return nanos[static_cast<std::size_t>(q * (nanos.size() - 1))]; };
+    std::printf("%-10s %-4s p50 %6.0f ns   p99 %6.0f ns   p99.99 %8.0f ns   max %9.0f ns\n",
+                name, op, at(0.5), at(0.99), at(0.9999), nanos.back());
+}
+
+// Pushes the whole burst, then drains it, timing every operation
+template <class Q, class Footprint>
+void run(const char* name, Q& q, Footprint footprint) {
+    std::vector<float> pushes(kBurst), pops(kBurst);
+    std::size_t peak = 0;
+    for (std::size_t i = 0; i < kBurst; ++i) {
+        auto start = Clock::now();
+        q.push(static_cast<std::uint64_t>(i));
+        pushes[i] = std::chrono::duration<float, std::nano>(Clock::now() - start).count();
+        if ((i & 4095) == 0) {
+            peak = std::max(peak, footprint(q));
+        }
+    }
+    peak = std::max(peak, footprint(q));
+
+    std::uint64_t checksum = 0;
+    for (std::size_t i = 0; i < kBurst; ++i) {
+        auto start = Clock::now();
+        checksum += q.front();
+        q.pop();
+        pops[i] = std::chrono::duration<float, std::nano>(Clock::now() - start).count();
+    }
+    if (checksum != static_cast<std::uint64_t>(kBurst) * (kBurst - 1) / 2) {
+        std::printf("checksum mismatch\n");
+    }
+
+    std::printf("%-10s peak element memory %.1f MiB\n", name, peak / 1048576.0);
+    report(name, "push", pushes);
+    report(name, "pop", pops);
+}
+
+} // namespace
+
+int main() {
+    {
+        ds::Queue<std::uint64_t> q;
+        run("Queue", q, [](const ds::Queue<std::uint64_t>& q) { return q.capacity() * sizeof(std::uint64_t); });
+    }
+    {
+        ds::SpillOptions options;
+        options.memoryBudget = 32u << 20;
+        ds::SpillQueue<std::uint64_t> q(options);
+        run("SpillQueue", q, [](const ds::SpillQueue<std::uint64_t>& q) { return q.memoryBytes(); });
+    }
+    return 0;
+}
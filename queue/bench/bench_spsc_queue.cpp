@@ -0,0 +1,162 @@
+// bench_spsc_queue.cpp
+// SpscQueue between two pinned threads: messages per second, one at a time
+// and in batches, against a mutex-wrapped Queue, and the round-trip latency
+// of a ping-pong over two queues.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "queue.hpp"
+#include "spsc_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kMessages = 20000000;
+constexpr std::size_t kRoundTrips = 200000;
+
+// Pins the calling thread to one CPU, where the platform allows it
+void pin(unsigned cpu) {
+#ifdef __linux__
+    unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// Spins, then yields, so the bench also finishes on a single core
+template <class Try>
+void retry(Try attempt) {
+    for (unsigned spins = 0; !attempt(); ++spins) {
+        if (spins > 1000) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+class LockedQueue {
+public:
+    bool tryPush(std::uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(value);
+        return true;
+    }
+
+    bool tryPop(std::uint64_t& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        out = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    ds::Queue<std::uint64_t> queue_;
+};
+
+template <class Q>
+double throughput(Q& q) {
+    auto start = Clock::now();
+    std::thread consumer([&q] {
+        pin(1);
+        std::uint64_t out = 0;
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            retry([&] { return q.tryPop(out); });
+        }
+    });
+    pin(0);
+    for (std::uint64_t i = 0; i < kMessages; ++i) {
+        retry([&] { return q.tryPush(i); });
+    }
+    consumer.join();
+    return kMessages / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double batchedThroughput(std::size_t batch) {
+    ds::SpscQueue<std::uint64_t> q(1024);
+    auto start = Clock::now();
+    std::thread consumer([&q, batch] {
+        pin(1);
+        std::vector<std::uint64_t> out(batch);
+        for (std::size_t received = 0; received < kMessages;) {
+            std::size_t n = 0;
+            retry([&] { return (n = q.tryPopN(out.data(), batch)) > 0; });
+            received += n;
+        }
+    });
+    pin(0);
+    std::vector<std::uint64_t> items(batch);
+    for (std::size_t sent = 0; sent < kMessages;) {
+        std::size_t want = std::min(batch, kMessages - sent);
+        std::size_t n = 0;
+        retry([&] { return (n = q.tryPushN(items.data(), want)) > 0; });
+        sent += n;
+    }
+    consumer.join();
+    return kMessages / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void roundTrip() {
+    ds::SpscQueue<std::uint64_t> ping(64);
+    ds::SpscQueue<std::uint64_t> pong(64);
+
+    std::thread echo([&] {
+        pin(1);
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < kRoundTrips; ++i) {
+            retry([&] { return ping.tryPop(value); });
+            retry([&] { return pong.tryPush(value); });
+        }
+    });
+
+    pin(0);
+    std::vector<double> samples(kRoundTrips);
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < kRoundTrips; ++i) {
+        auto start = Clock::now();
+        retry([&] { return ping.tryPush(i); });
+        retry([&] { return pong.tryPop(value); });
+        samples[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    std::printf("round trip            p50 %8.0f ns   p99 %8.0f ns   max %10.0f ns\n",
+                samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back());
+}
+
+} // namespace
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    LockedQueue locked;
+    std::printf("mutex + Queue         %8.1f M msg/s\n", throughput(locked) / 1e6);
+    ds::SpscQueue<std::uint64_t> spsc(1024);
+    std::printf("SpscQueue             %8.1f M msg/s\n", throughput(spsc) / 1e6);
+    for (std::size_t batch : {8u, 64u}) {
+        std::printf("SpscQueue batch=%-4zu  %8.1f M msg/s\n", batch, batchedThroughput(batch) / 1e6);
+    }
+    roundTrip();
+    return 0;
+}
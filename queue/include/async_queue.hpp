@@ -0,0 +1,352 @@
+#pragma once
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "queue.hpp"
+
+namespace ds {
+
+// Executor: where a coroutine woken up by a push is resumed
+class Executor{
+public:
+    virtual ~Executor() = default;
+
+    virtual void execute(std::coroutine_handle<> handle) = 0;
+};
+
+// Resumes the coroutine at once on the pushing thread, before push returns
+class InlineExecutor final : public Executor{
+public:
+    void execute(std::coroutine_handle<> handle) override { handle.resume(); }
+};
+
+inline Executor& inlineExecutor() {
+    static InlineExecutor executor;
+    return executor;
+}
+
+// AsyncQueue: a Queue shared between threads and coroutines, where
+// co_await pop() suspends the coroutine instead of blocking its thread.
+//
+// A pop that finds the queue empty parks its coroutine on a FIFO list of
+// waiters. A push hands its element straight to the oldest waiter, outside
+// the queue, and has the queue's executor resume that coroutine: inline by
+// default, or on whatever thread or event loop the executor stands for. So
+// an element never sits in the queue while a coroutine waits for one, and
+// waiters are served in the order they arrived.
+//
+// close() starts shutdown: later pushes fail, waiting coroutines resume
+// with nothing, and pops drain what is left before they too get nothing.
+template<typename T>
+class AsyncQueue{
+    struct Waiter;
+
+public:
+    using size_type = std::size_t;
+
+    class PopAwaiter;
+    class PopNAwaiter;
+
+    explicit AsyncQueue(Executor& executor = inlineExecutor()) noexcept;
+    ~AsyncQueue();
+
+    AsyncQueue(const AsyncQueue&) = delete;
+    AsyncQueue& operator=(const AsyncQueue&) = delete;
+
+    // Returns false, dropping nothing, if the queue is closed
+    template<class U>
+    bool push(U&& value);
+
+    // Pushes copies of first[0, n) in order, waking as many waiters as they
+    // serve. Returns false, pushing nothing, if the queue is closed.
+    bool pushN(const T* first, size_type n);
+
+    // co_await gives std::optional<T>: the front element, or std::nullopt
+    // once the queue is closed and empty
+    PopAwaiter pop() noexcept;
+
+    // co_await waits for at least one element, then moves up to maxBatch
+    // elements into out[0, maxBatch) and gives how many, 0 once the queue
+    // is closed and empty
+    PopNAwaiter popN(T* out, size_type maxBatch) noexcept;
+
+    // Never suspends
+    bool tryPop(T& out);
+
+    void close();
+    bool closed() const;
+
+    size_type size() const;
+    bool empty() const;
+
+private:
+    // A suspended pop, living in its awaiter in the coroutine frame
+    struct Waiter {
+        Waiter* next = nullptr;
+        std::coroutine_handle<> handle;
+        std::optional<T>* single = nullptr;     // for pop
+        T* batch = nullptr;                     // for popN
+        size_type maxBatch = 0;
+        size_type taken = 0;
+
+        bool full() const noexcept { return single != nullptr ? single->has_value() : taken == maxBatch; }
+    };
+
+    // Hands value to the oldest waiter; called with the lock held
+    template<class U>
+    void deliver(Waiter& waiter, U&& value);
+
+    void enqueueWaiter(Waiter* waiter) noexcept;
+    Waiter* dequeueWaiter() noexcept;
+
+    // Resumes each waiter of a list linked through next; called unlocked
+    void resume(Waiter* list);
+
+private:
+    mutable std::mutex mutex_;
+    Queue<T> queue_;                        // empty while anyone waits
+    Waiter* waitHead_ = nullptr;
+    Waiter* waitTail_ = nullptr;
+    Executor* executor_;
+    bool closed_ = false;
+};
+
+template<typename T>
+class AsyncQueue<T>::PopAwaiter{
+public:
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle);
+    std::optional<T> await_resume() { return std::move(value_); }
+
+private:
+    friend class AsyncQueue;
+
+    explicit PopAwaiter(AsyncQueue& queue) noexcept : queue_(queue) {}
+
+    AsyncQueue& queue_;
+    Waiter waiter_;
+    std::optional<T> value_;
+};
+
+template<typename T>
+class AsyncQueue<T>::PopNAwaiter{
+public:
+    bool await_ready() const noexcept { return maxBatch_ == 0; }
+    bool await_suspend(std::coroutine_handle<> handle);
+    size_type await_resume() const noexcept { return waiter_.taken; }
+
+private:
+    friend class AsyncQueue;
+
+    PopNAwaiter(AsyncQueue& queue, T* out, size_type maxBatch) noexcept
+        : queue_(queue), out_(out), maxBatch_(maxBatch) {}
+
+    AsyncQueue& queue_;
+    T* out_;
+    size_type maxBatch_;
+    Waiter waiter_;
+};
+
+template<typename T>
+AsyncQueue<T>::AsyncQueue(Executor& executor) noexcept
+    : executor_(&executor) {}
+
+template<typename T>
+AsyncQueue<T>::~AsyncQueue() {
+    assert(waitHead_ == nullptr && "Coroutines still wait on a destroyed queue");
+}
+
+template<typename T>
+template<class U>
+bool AsyncQueue<T>::push(U&& value) {
+    Waiter* waiter = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+        if (waitHead_ == nullptr) {
+            queue_.push(std::forward<U>(value));
+            return true;
+        }
+        deliver(*waitHead_, std::forward<U>(value));
+        waiter = dequeueWaiter();
+    }
+    resume(waiter);
+    return true;
+}
+
+// A batch waiter takes as many elements as fit before the next waiter is
+// served; if a copy throws, the waiters already served still resume
+template<typename T>
+bool AsyncQueue<T>::pushN(const T* first, size_type n) {
+    Waiter* ready = nullptr;
+    Waiter** readyTail = &ready;
+    try {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+        size_type i = 0;
+        while (i < n && waitHead_ != nullptr) {
+            while (i < n && !waitHead_->full()) {
+                deliver(*waitHead_, first[i]);
+                ++i;
+            }
+            *readyTail = dequeueWaiter();
+            readyTail = &(*readyTail)->next;
+        }
+        for (; i < n; ++i) {
+            queue_.push(first[i]);
+        }
+    } catch (...) {
+        resume(ready);
+        throw;
+    }
+    resume(ready);
+    return true;
+}
+
+template<typename T>
+typename AsyncQueue<T>::PopAwaiter AsyncQueue<T>::pop() noexcept {
+    return PopAwaiter(*this);
+}
+
+template<typename T>
+typename AsyncQueue<T>::PopNAwaiter AsyncQueue<T>::popN(T* out, size_type maxBatch) noexcept {
+    return PopNAwaiter(*this, out, maxBatch);
+}
+
+template<typename T>
+bool AsyncQueue<T>::tryPop(T& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+        return false;
+    }
+    out = std::move(queue_.front());
+    queue_.pop();
+    return true;
+}
+
+template<typename T>
+void AsyncQueue<T>::close() {
+    Waiter* waiters = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        waiters = waitHead_;
+        waitHead_ = nullptr;
+        waitTail_ = nullptr;
+    }
+    resume(waiters);
+}
+
+template<typename T>
+bool AsyncQueue<T>::closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+template<typename T>
+typename AsyncQueue<T>::size_type AsyncQueue<T>::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+template<typename T>
+bool AsyncQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+template<class U>
+void AsyncQueue<T>::deliver(Waiter& waiter, U&& value) {
+    if (waiter.single != nullptr) {
+        waiter.single->emplace(std::forward<U>(value));
+    } else {
+        waiter.batch[waiter.taken] = std::forward<U>(value);
+        ++waiter.taken;
+    }
+}
+
+template<typename T>
+void AsyncQueue<T>::enqueueWaiter(Waiter* waiter) noexcept {
+    waiter->next = nullptr;
+    if (waitTail_ == nullptr) {
+        waitHead_ = waiter;
+    } else {
+        waitTail_->next = waiter;
+    }
+    waitTail_ = waiter;
+}
+
+template<typename T>
+typename AsyncQueue<T>::Waiter* AsyncQueue<T>::dequeueWaiter() noexcept {
+    Waiter* waiter = waitHead_;
+    waitHead_ = waiter->next;
+    if (waitHead_ == nullptr) {
+        waitTail_ = nullptr;
+    }
+    waiter->next = nullptr;
+    return waiter;
+}
+
+// A resumed coroutine may at once destroy its waiter, or even the queue, so
+// nothing is read from either after it runs
+template<typename T>
+void AsyncQueue<T>::resume(Waiter* list) {
+    Executor* executor = executor_;
+    while (list != nullptr) {
+        Waiter* next = list->next;
+        executor->execute(list->handle);
+        list = next;
+    }
+}
+
+// Completes without suspending when an element is there or the queue is
+// closed. Once the waiter is listed a push may resume the coroutine on
+// another thread, so nothing of the awaiter is touched after unlocking.
+template<typename T>
+bool AsyncQueue<T>::PopAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(queue_.mutex_);
+    if (!queue_.queue_.empty()) {
+        value_.emplace(std::move(queue_.queue_.front()));
+        queue_.queue_.pop();
+        return false;
+    }
+    if (queue_.closed_) {
+        return false;
+    }
+    waiter_.handle = handle;
+    waiter_.single = &value_;
+    queue_.enqueueWaiter(&waiter_);
+    return true;
+}
+
+template<typename T>
+bool AsyncQueue<T>::PopNAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(queue_.mutex_);
+    if (!queue_.queue_.empty()) {
+        while (waiter_.taken < maxBatch_ && !queue_.queue_.empty()) {
+            out_[waiter_.taken] = std::move(queue_.queue_.front());
+            queue_.queue_.pop();
+            ++waiter_.taken;
+        }
+        return false;
+    }
+    if (queue_.closed_) {
+        return false;
+    }
+    waiter_.handle = handle;
+    waiter_.batch = out_;
+    waiter_.maxBatch = maxBatch_;
+    queue_.enqueueWaiter(&waiter_);
+    return true;
+}
+
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "queue.hpp"
+
+namespace ds {
+
+namespace detail {
+
+// Tells the CPU we are in a spin-wait loop
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace detail
+
+// BlockingQueue: a Queue shared between threads whose consumers wait for
+// elements instead of polling.
+//
+// A consumer that finds the queue empty first spins briefly, watching an
+// atomic element count without taking the lock, so that under load it
+// picks up the next element without a sleep and a wake-up. Only then does
+// it park on a condition variable (a futex on Linux), using no CPU until a
+// producer notifies it. Producers notify only when somebody is parked.
+//
+// close() starts shutdown: later pushes fail, waiting consumers wake up,
+// and pops drain what is left before they too report failure.
+template<typename T>
+class BlockingQueue{
+public:
+    using size_type = std::size_t;
+
+    BlockingQueue() = default;
+
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    // Returns false, dropping nothing, if the queue is closed
+    template<class U>
+    bool push(U&& value);
+
+    // Waits for an element. Returns false once the queue is closed and empty.
+    bool pop(T& out);
+
+    // As pop, but also returns false if nothing arrives within timeout
+    template<class Rep, class Period>
+    bool pop(T& out, const std::chrono::duration<Rep, Period>& timeout);
+
+    // Never waits
+    bool tryPop(T& out);
+
+    // Waits for at least one element, then moves up to maxBatch elements into
+    // out[0, maxBatch) under one lock. Returns how many it moved, 0 once the
+    // queue is closed and empty.
+    size_type waitPopN(T* out, size_type maxBatch);
+
+    void close();
+    bool closed() const;
+
+    size_type size() const;
+    bool empty() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Spin iterations before parking; none on a single CPU, where the
+    // producer cannot run while we spin
+    static size_type spinLimit() noexcept {
+        static const size_type limit = std::thread::hardware_concurrency() > 1 ? 2000 : 0;
+        return limit;
+    }
+
+    void spinWhileEmpty() const noexcept;
+
+    // Locks, waiting until the queue has an element or is closed, or until
+    // deadline if there is one. Returns true if an element is available.
+    bool waitReady(std::unique_lock<std::mutex>& lock, const Clock::time_point* deadline);
+
+    void take(T& out);
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    Queue<T> queue_;
+    size_type waiters_ = 0;                 // guarded by mutex_
+    bool closed_ = false;                   // guarded by mutex_
+
+    // Mirrors queue_.size() and closed_ for spinning without the lock
+    std::atomic<size_type> count_{0};
+    std::atomic<bool> closing_{false};
+};
+
+template<typename T>
+template<class U>
+bool BlockingQueue<T>::push(U&& value) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+        queue_.push(std::forward<U>(value));
+        count_.fetch_add(1, std::memory_order_release);
+        wake = waiters_ > 0;
+    }
+    if (wake) {
+        ready_.notify_one();
+    }
+    return true;
+}
+
+template<typename T>
+bool BlockingQueue<T>::pop(T& out) {
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!waitReady(lock, nullptr)) {
+        return false;
+    }
+    take(out);
+    return true;
+}
+
+template<typename T>
+template<class Rep, class Period>
+bool BlockingQueue<T>::pop(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+    Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!waitReady(lock, &deadline)) {
+        return false;
+    }
+    take(out);
+    return true;
+}
+
+template<typename T>
+bool BlockingQueue<T>::tryPop(T& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+        return false;
+    }
+    take(out);
+    return true;
+}
+
+template<typename T>
+typename BlockingQueue<T>::size_type BlockingQueue<T>::waitPopN(T* out, size_type maxBatch) {
+    if (maxBatch == 0) {
+        return 0;
+    }
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!waitReady(lock, nullptr)) {
+        return 0;
+    }
+    size_type n = 0;
+    while (n < maxBatch && !queue_.empty()) {
+        take(out[n]);
+        ++n;
+    }
+    return n;
+}
+
+template<typename T>
+void BlockingQueue<T>::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        closing_.store(true, std::memory_order_relaxed);
+    }
+    ready_.notify_all();
+}
+
+template<typename T>
+bool BlockingQueue<T>::closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+template<typename T>
+typename BlockingQueue<T>::size_type BlockingQueue<T>::size() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+template<typename T>
+bool BlockingQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+void BlockingQueue<T>::spinWhileEmpty() const noexcept {
+    for (size_type i = spinLimit(); i > 0; --i) {
+        if (count_.load(std::memory_order_relaxed) > 0 || closing_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        detail::cpuRelax();
+    }
+}
+
+template<typename T>
+bool BlockingQueue<T>::waitReady(std::unique_lock<std::mutex>& lock, const Clock::time_point* deadline) {
+    spinWhileEmpty();
+    lock.lock();
+    while (queue_.empty() && !closed_) {
+        ++waiters_;
+        if (deadline == nullptr) {
+            ready_.wait(lock);
+        } else if (ready_.wait_until(lock, *deadline) == std::cv_status::timeout) {
+            --waiters_;
+            return !queue_.empty();
+        }
+        --waiters_;
+    }
+    return !queue_.empty();
+}
+
+// Called with the lock held and the queue non-empty
+template<typename T>
+void BlockingQueue<T>::take(T& out) {
+    out = std::move(queue_.front());
+    queue_.pop();
+    count_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}
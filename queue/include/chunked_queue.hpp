@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ds {
+
+// ChunkedQueue: a FIFO queue in a linked list of fixed-size blocks (an
+// unrolled list).
+//
+// Each block of about BlockBytes holds many elements in a row, with its own
+// head and tail index: pushes fill the back block, pops drain the front one,
+// and a drained block is kept as a spare for the next push that needs one.
+// So elements pay no pointer each, draining walks memory in order, and
+// unlike Queue growth never moves or copies an element, which keeps
+// references to the elements stable and the cost of each push bounded.
+template<typename T, std::size_t BlockBytes = 4096>
+class ChunkedQueue{
+public:
+    using size_type = std::size_t;
+
+    ChunkedQueue() noexcept = default;
+    ~ChunkedQueue();
+
+    ChunkedQueue(const ChunkedQueue& other);
+    ChunkedQueue(ChunkedQueue&& other) noexcept;
+    ChunkedQueue& operator=(ChunkedQueue other) noexcept;
+
+    template<class U>
+    void push(U&& u);
+
+    void pop();
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    size_type size() const;
+    bool empty() const;
+
+    // Blocks held, including the spare
+    size_type blockCount() const;
+
+    static constexpr size_type blockCapacity() noexcept { return kPerBlock; }
+    static constexpr size_type blockBytes() noexcept { return sizeof(Block); }
+
+private:
+    struct Header {
+        void* next;
+        size_type head;
+        size_type tail;
+    };
+
+    static constexpr size_type kPerBlock =
+        BlockBytes > sizeof(Header) + sizeof(T) ? (BlockBytes - sizeof(Header)) / sizeof(T) : 1;
+
+    struct Block {
+        Block* next = nullptr;
+        size_type head = 0;                     // first live slot
+        size_type tail = 0;                     // one past the last live slot
+        alignas(T) unsigned char bytes[kPerBlock * sizeof(T)];
+
+        T* at(size_type i) noexcept { return reinterpret_cast<T*>(bytes) + i; }
+    };
+
+    // The spare if there is one, else a new block; either way empty
+    Block* acquire();
+
+    // Keeps block as the spare, or frees it if there already is one
+    void recycle(Block* block) noexcept;
+
+    void swap(ChunkedQueue& other) noexcept;
+    void clear() noexcept;
+
+private:
+    Block* head_ = nullptr;         // block holding the front element
+    Block* tail_ = nullptr;         // block holding the back element
+    Block* spare_ = nullptr;
+    size_type size_ = 0;
+    size_type blocks_ = 0;
+};
+
+template<typename T, std::size_t BlockBytes>
+ChunkedQueue<T, BlockBytes>::~ChunkedQueue() {
+    clear();
+    recycle(head_);
+    delete spare_;
+}
+
+// Delegates first so that a throwing copy destroys what was already pushed
+template<typename T, std::size_t BlockBytes>
+ChunkedQueue<T, BlockBytes>::ChunkedQueue(const ChunkedQueue& other)
+    : ChunkedQueue() {
+    for (Block* block = other.head_; block != nullptr; block = block->next) {
+        for (size_type i = block->head; i < block->tail; ++i) {
+            push(*block->at(i));
+        }
+    }
+}
+
+template<typename T, std::size_t BlockBytes>
+ChunkedQueue<T, BlockBytes>::ChunkedQueue(ChunkedQueue&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), spare_(other.spare_), size_(other.size_),
+      blocks_(other.blocks_) {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.spare_ = nullptr;
+    other.size_ = 0;
+    other.blocks_ = 0;
+}
+
+template<typename T, std::size_t BlockBytes>
+ChunkedQueue<T, BlockBytes>& ChunkedQueue<T, BlockBytes>::operator=(ChunkedQueue other) noexcept {
+    swap(other);
+    return *this;
+}
+
+// A full back block gets a successor; the element is built in it before it
+// is linked, so a throwing constructor leaves the queue as it was
+template<typename T, std::size_t BlockBytes>
+template<class U>
+void ChunkedQueue<T, BlockBytes>::push(U&& u) {
+    if (tail_ != nullptr && tail_->tail < kPerBlock) {
+        ::new (static_cast<void*>(tail_->at(tail_->tail))) T(std::forward<U>(u));
+        ++tail_->tail;
+        ++size_;
+        return;
+    }
+
+    Block* block = acquire();
+    try {
+        ::new (static_cast<void*>(block->at(0))) T(std::forward<U>(u));
+    } catch (...) {
+        recycle(block);
+        throw;
+    }
+    block->tail = 1;
+    if (tail_ == nullptr) {
+        head_ = block;
+    } else {
+        tail_->next = block;
+    }
+    tail_ = block;
+    ++size_;
+}
+
+// The last block is kept rather than recycled, rewound to its start
+template<typename T, std::size_t BlockBytes>
+void ChunkedQueue<T, BlockBytes>::pop() {
+    assert(!empty() && "Queue is empty");
+    Block* block = head_;
+    size_type next = block->head + 1;
+    std::destroy_at(block->at(block->head));
+    block->head = next;
+    --size_;
+    if (next < block->tail) {
+        return;
+    }
+    if (block->next == nullptr) {
+        block->head = 0;
+        block->tail = 0;
+    } else {
+        head_ = block->next;
+        recycle(block);
+    }
+}
+
+template<typename T, std::size_t BlockBytes>
+T& ChunkedQueue<T, BlockBytes>::front() {
+    assert(!empty() && "Queue is empty");
+    return *head_->at(head_->head);
+}
+
+template<typename T, std::size_t BlockBytes>
+const T& ChunkedQueue<T, BlockBytes>::front() const {
+    assert(!empty() && "Queue is empty");
+    return *head_->at(head_->head);
+}
+
+template<typename T, std::size_t BlockBytes>
+T& ChunkedQueue<T, BlockBytes>::back() {
+    assert(!empty() && "Queue is empty");
+    return *tail_->at(tail_->tail - 1);
+}
+
+template<typename T, std::size_t BlockBytes>
+const T& ChunkedQueue<T, BlockBytes>::back() const {
+    assert(!empty() && "Queue is empty");
+    return *tail_->at(tail_->tail - 1);
+}
+
+template<typename T, std::size_t BlockBytes>
+typename ChunkedQueue<T, BlockBytes>::size_type ChunkedQueue<T, BlockBytes>::size() const {
+    return size_;
+}
+
+template<typename T, std::size_t BlockBytes>
+bool ChunkedQueue<T, BlockBytes>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, std::size_t BlockBytes>
+typename ChunkedQueue<T, BlockBytes>::size_type ChunkedQueue<T, BlockBytes>::blockCount() const {
+    return blocks_;
+}
+
+template<typename T, std::size_t BlockBytes>
+typename ChunkedQueue<T, BlockBytes>::Block* ChunkedQueue<T, BlockBytes>::acquire() {
+    Block* block = spare_;
+    if (block != nullptr) {
+        spare_ = nullptr;
+        block->next = nullptr;
+        block->head = 0;
+        block->tail = 0;
+        return block;
+    }
+    block = new Block;
+    ++blocks_;
+    return block;
+}
+
+template<typename T, std::size_t BlockBytes>
+void ChunkedQueue<T, BlockBytes>::recycle(Block* block) noexcept {
+    if (block == nullptr) {
+        return;
+    }
+    if (spare_ == nullptr) {
+        spare_ = block;
+    } else {
+        delete block;
+        --blocks_;
+    }
+}
+
+template<typename T, std::size_t BlockBytes>
+void ChunkedQueue<T, BlockBytes>::swap(ChunkedQueue& other) noexcept {
+    using std::swap;
+    swap(head_, other.head_);
+    swap(tail_, other.tail_);
+    swap(spare_, other.spare_);
+    swap(size_, other.size_);
+    swap(blocks_, other.blocks_);
+}
+
+// Destroys every element, keeping at most one block besides the spare
+template<typename T, std::size_t BlockBytes>
+void ChunkedQueue<T, BlockBytes>::clear() noexcept {
+    while (!empty()) {
+        pop();
+    }
+}
+
+}
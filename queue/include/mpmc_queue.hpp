@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+// MpmcQueue: a bounded lock-free FIFO queue for any number of producer and
+// consumer threads (Dmitry Vyukov's array queue).
+//
+// Every slot carries a sequence number that says whose turn it is. A slot
+// at position pos is free for the producer that claims pos when its
+// sequence is pos, and full for the consumer that claims pos when it is
+// pos + 1; the consumer then sets it to pos + capacity, the next lap's
+// producer position. Producers and consumers claim positions with a CAS on
+// their own counter and then touch only the claimed slot, so they contend
+// only with their own kind, never through a shared lock.
+//
+// A claimed slot must be finished, so T's move constructor must not throw;
+// a push whose conversion to T might throw builds the element first.
+template<typename T>
+class MpmcQueue{
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "MpmcQueue moves elements in and out of claimed slots");
+
+public:
+    using size_type = std::size_t;
+
+    explicit MpmcQueue(size_type capacity);
+    ~MpmcQueue();
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Returns false if the queue is full
+    template<class U>
+    bool tryPush(U&& value);
+
+    // Returns false if the queue is empty
+    bool tryPop(T& out);
+
+    // A snapshot that other threads may already have changed
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    size_type capacity() const noexcept;
+
+private:
+    static constexpr size_type kCacheLine = 64;
+
+    struct Cell {
+        std::atomic<size_type> sequence;
+        alignas(T) unsigned char bytes[sizeof(T)];
+
+        T* value() noexcept { return reinterpret_cast<T*>(bytes); }
+    };
+
+    // Claims the slot for position pos, or returns nullptr if the queue is full
+    Cell* claimForPush(size_type& pos) noexcept;
+
+    // Claims the slot for position pos, or returns nullptr if the queue is empty
+    Cell* claimForPop(size_type& pos) noexcept;
+
+private:
+    alignas(kCacheLine) std::atomic<size_type> enqueuePos_{0};
+    alignas(kCacheLine) std::atomic<size_type> dequeuePos_{0};
+    alignas(kCacheLine) Cell* cells_ = nullptr;
+    size_type mask_ = 0;
+};
+
+template<typename T>
+MpmcQueue<T>::MpmcQueue(size_type capacity) {
+    size_type rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    cells_ = std::allocator<Cell>().allocate(rounded);
+    for (size_type i = 0; i < rounded; ++i) {
+        ::new (static_cast<void*>(cells_ + i)) Cell;
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask_ = rounded - 1;
+}
+
+template<typename T>
+MpmcQueue<T>::~MpmcQueue() {
+    size_type pos = 0;
+    while (Cell* cell = claimForPop(pos)) {
+        std::destroy_at(cell->value());
+    }
+    std::allocator<Cell>().deallocate(cells_, mask_ + 1);
+}
+
+template<typename T>
+template<class U>
+bool MpmcQueue<T>::tryPush(U&& value) {
+    size_type pos = 0;
+    if constexpr (std::is_nothrow_constructible_v<T, U&&>) {
+        Cell* cell = claimForPush(pos);
+        if (cell == nullptr) {
+            return false;
+        }
+        ::new (static_cast<void*>(cell->value())) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+    } else {
+        T item(std::forward<U>(value));
+        Cell* cell = claimForPush(pos);
+        if (cell == nullptr) {
+            return false;
+        }
+        ::new (static_cast<void*>(cell->value())) T(std::move(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+// The slot is handed back before assigning to out, which may throw
+template<typename T>
+bool MpmcQueue<T>::tryPop(T& out) {
+    size_type pos = 0;
+    Cell* cell = claimForPop(pos);
+    if (cell == nullptr) {
+        return false;
+    }
+    T item(std::move(*cell->value()));
+    std::destroy_at(cell->value());
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+    out = std::move(item);
+    return true;
+}
+
+template<typename T>
+typename MpmcQueue<T>::size_type MpmcQueue<T>::size() const noexcept {
+    size_type dequeued = dequeuePos_.load(std::memory_order_relaxed);
+    size_type enqueued = enqueuePos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+template<typename T>
+bool MpmcQueue<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template<typename T>
+typename MpmcQueue<T>::size_type MpmcQueue<T>::capacity() const noexcept {
+    return mask_ + 1;
+}
+
+// The acquire load of the sequence pairs with the release store of the
+// consumer that emptied the slot on the previous lap
+template<typename T>
+typename MpmcQueue<T>::Cell* MpmcQueue<T>::claimForPush(size_type& pos) noexcept {
+    pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* cell = &cells_[pos & mask_];
+        size_type sequence = cell->sequence.load(std::memory_order_acquire);
+        auto lag = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (lag == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (lag < 0) {
+            return nullptr;             // Still full from the previous lap
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// The acquire load of the sequence pairs with the producer's release store
+template<typename T>
+typename MpmcQueue<T>::Cell* MpmcQueue<T>::claimForPop(size_type& pos) noexcept {
+    pos = dequeuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* cell = &cells_[pos & mask_];
+        size_type sequence = cell->sequence.load(std::memory_order_acquire);
+        auto lag = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+        if (lag == 0) {
+            if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (lag < 0) {
+            return nullptr;             // Not yet filled for this lap
+        } else {
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+}
@@ -2,37 +2,26 @@
 
 #include <cstddef>
 #include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace ds {
 
+// Queue: a FIFO queue in a circular buffer.
+//
+// The elements live in one contiguous power-of-two buffer with the front at
+// head_, so the i-th element is in slot (head_ + i) & (capacity - 1): no
+// node allocation per push, no pointers per element and no modulo. A full
+// queue doubles its buffer, moving the elements once, in order, to the
+// start of the new one. The buffer is allocated by the first push.
 template<typename T>
 class Queue{
 public:
     using size_type = std::size_t;
 
-private:
-    struct Node {
-        T data;
-        Node* prev;
-        Node* next;
-
-        Node() : data(), prev(this), next(this) {}
-
-        template<class U>
-        explicit Node(U&& u) 
-            : data(std::forward<U>(u)), prev(nullptr), next(nullptr) 
-        {}
-
-        Node(const Node&) = delete;
-        Node& operator=(const Node&) = delete;
-    };
-    
-    size_type size_ = 0;
-    Node* head_ = nullptr;
-
-public: 
-    Queue();
+    Queue() noexcept = default;
     ~Queue();
 
     Queue(const Queue& other);
@@ -50,44 +39,65 @@ public:
     const T& back() const;
 
     size_type size() const;
-    
-    bool empty() const;
+    size_type capacity() const;
 
+    bool empty() const;
 
 private:
+    static constexpr size_type kInitialCapacity = 8;
+
+    size_type slot(size_type index) const noexcept { return index & (capacity_ - 1); }
+
+    // The elements as at most two contiguous runs: [head_, head_ + first)
+    // and [0, size_ - first)
+    size_type firstRun() const noexcept;
+
+    // Constructs copies, or with Move moved-from values, of the elements at
+    // the start of the uninitialized buffer to, in order
+    template<bool Move, class Source>
+    static void transferTo(Source& source, T* to);
+
+    void grow();
     void swap(Queue& other) noexcept;
-    void clear();
-    
-};
+    void clear() noexcept;
 
-template<typename T>
-Queue<T>::Queue()
-    :size_(0), head_(new Node())
-{}
+private:
+    T* data_ = nullptr;             // uninitialized storage, nullptr until the first push
+    size_type capacity_ = 0;        // 0 or a power of two
+    size_type head_ = 0;            // slot of the front element
+    size_type size_ = 0;
+};
 
 template<typename T>
 Queue<T>::~Queue() {
-    if (head_) {
-        clear();
-        delete head_;
-        head_ = nullptr;
-    }
+    clear();
+    std::allocator<T>().deallocate(data_, capacity_);
+    data_ = nullptr;
+    capacity_ = 0;
 }
 
 template<typename T>
-Queue<T>::Queue(const Queue<T>& other) 
-    : size_(0), head_(new Node()) {
-    Node* curr = other.head_->next;
-    while (curr != other.head_) {
-        push(curr->data);
-        curr = curr->next;
+Queue<T>::Queue(const Queue<T>& other)
+    : capacity_(other.capacity_) {
+    if (capacity_ == 0) {
+        return;
+    }
+    data_ = std::allocator<T>().allocate(capacity_);
+    try {
+        transferTo<false>(other, data_);
+    } catch (...) {
+        std::allocator<T>().deallocate(data_, capacity_);
+        throw;
     }
+    size_ = other.size_;
 }
 
 template<typename T>
 Queue<T>::Queue(Queue<T>&& other) noexcept
-    : size_(other.size_), head_(other.head_){
-    other.head_ = nullptr;
+    : data_(other.data_), capacity_(other.capacity_), head_(other.head_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+    other.head_ = 0;
     other.size_ = 0;
 }
 
@@ -100,72 +110,139 @@ Queue<T>& Queue<T>::operator=(Queue<T> other) noexcept {
 template<typename T>
 template<class U>
 void Queue<T>::push(U&& u) {
-    Node* newNode = new Node(std::forward<U>(u));
-    newNode->next = head_;
-    newNode->prev = head_->prev;
-    head_->prev->next = newNode;
-    head_->prev = newNode;
+    if (size_ < capacity_) {
+        ::new (static_cast<void*>(data_ + slot(head_ + size_))) T(std::forward<U>(u));
+        ++size_;
+        return;
+    }
 
+    // u may be front() or back() itself, so materialize it before growth moves it
+    T tmp(std::forward<U>(u));
+    grow();
+    ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
     ++size_;
 }
 
 template<typename T>
 void Queue<T>::pop(){
     assert(!empty() && "Queue is empty");
-    Node* front = head_->next;
-    head_->next = front->next;
-    front->next->prev = head_;
-    delete front;
-
+    std::destroy_at(data_ + head_);
+    head_ = slot(head_ + 1);
     --size_;
 }
 
 template<typename T>
 T& Queue<T>::front() {
     assert(!empty() && "Queue is empty");
-    return head_->next->data;
+    return data_[head_];
 }
 
 template<typename T>
 const T& Queue<T>::front() const {
     assert(!empty() && "Queue is empty");
-    return head_->next->data;
+    return data_[head_];
 }
 
 template<typename T>
 T& Queue<T>::back() {
     assert(!empty() && "Queue is empty");
-    return head_->prev->data;
+    return data_[slot(head_ + size_ - 1)];
 }
 
 template<typename T>
 const T& Queue<T>::back() const {
     assert(!empty() && "Queue is empty");
-    return head_->prev->data;
+    return data_[slot(head_ + size_ - 1)];
 }
 
 template<typename T>
 typename Queue<T>::size_type Queue<T>::size() const {
     return size_;
 }
-    
+
+template<typename T>
+typename Queue<T>::size_type Queue<T>::capacity() const {
+    return capacity_;
+}
+
 template<typename T>
 bool Queue<T>::empty() const {
     return size_ == 0;
 }
 
+template<typename T>
+typename Queue<T>::size_type Queue<T>::firstRun() const noexcept {
+    size_type toEnd = capacity_ - head_;
+    return size_ < toEnd ? size_ : toEnd;
+}
+
+template<typename T>
+template<bool Move, class Source>
+void Queue<T>::transferTo(Source& source, T* to) {
+    auto transfer = [](T* first, T* last, T* out) {
+        if constexpr (Move) {
+            std::uninitialized_move(first, last, out);
+        } else {
+            std::uninitialized_copy(first, last, out);
+        }
+    };
+
+    size_type first = source.firstRun();
+    T* begin = source.data_ + source.head_;
+    transfer(begin, begin + first, to);
+    try {
+        transfer(source.data_, source.data_ + (source.size_ - first), to + first);
+    } catch (...) {
+        std::destroy(to, to + first);
+        throw;
+    }
+}
+
+// Moves when that cannot throw (or copying is impossible), so a failed
+// growth leaves the queue as it was
+template<typename T>
+void Queue<T>::grow() {
+    size_type newCapacity = capacity_ == 0 ? kInitialCapacity : capacity_ * 2;
+    if (newCapacity < capacity_) {
+        throw std::bad_alloc();
+    }
+    T* newData = std::allocator<T>().allocate(newCapacity);
+    try {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>) {
+            transferTo<true>(*this, newData);
+        } else {
+            transferTo<false>(*this, newData);
+        }
+    } catch (...) {
+        std::allocator<T>().deallocate(newData, newCapacity);
+        throw;
+    }
+
+    size_type size = size_;
+    clear();
+    std::allocator<T>().deallocate(data_, capacity_);
+    data_ = newData;
+    capacity_ = newCapacity;
+    size_ = size;
+}
+
 template<typename T>
 void Queue<T>::swap(Queue<T>& other) noexcept {
     using std::swap;
+    swap(data_, other.data_);
+    swap(capacity_, other.capacity_);
     swap(head_, other.head_);
     swap(size_, other.size_);
 }
 
 template<typename T>
-void Queue<T>::clear() {
-    while (!empty()) {
-        pop();
-    }
+void Queue<T>::clear() noexcept {
+    size_type first = firstRun();
+    std::destroy(data_ + head_, data_ + head_ + first);
+    std::destroy(data_, data_ + (size_ - first));
+    head_ = 0;
+    size_ = 0;
 }
 
-}
\ No newline at end of file
+}
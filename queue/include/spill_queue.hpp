@@ -0,0 +1,495 @@
+#pragma once
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "queue.hpp"
+
+namespace ds {
+
+// MemcpyCodec: writes an element as its object representation
+template<typename T>
+struct MemcpyCodec{
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                  "MemcpyCodec needs a trivially copyable type; give SpillQueue a codec");
+
+    void encode(const T& value, std::vector<unsigned char>& out) const {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    T decode(const unsigned char*& in) const {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+};
+
+struct SpillOptions{
+    std::size_t memoryBudget = std::size_t(64) << 20;   // bytes of elements kept in RAM
+    std::size_t segmentBytes = std::size_t(1) << 20;    // bytes of elements per segment
+    std::string directory;                              // for segment files; empty: the system's temp directory
+};
+
+// SpillQueue: a FIFO queue that moves its middle to disk when it outgrows a
+// memory budget.
+//
+// The elements live in segments of segmentBytes: the head segment being
+// popped, the tail segment being pushed, and sealed segments in between.
+// When the tail fills up it is sealed, and if the elements in RAM then
+// exceed memoryBudget (counting sizeof(T) each) it is written to its own
+// append-only segment file instead of staying in memory. The head and tail
+// never leave RAM, so a push or pop touches the disk only when it seals or
+// starts a segment.
+//
+// Spilled segments are read back in order as they reach the head. When a
+// segment becomes the head, the kernel is advised to read the next spilled
+// one ahead (posix_fadvise), so that loading it is mostly a copy from the
+// page cache.
+//
+// Codec turns elements into bytes: encode(const T&, std::vector<unsigned
+// char>&) appends one element and decode(const unsigned char*&) reads one
+// back and advances. The default MemcpyCodec writes a whole segment with
+// one write(2) call. File errors throw std::system_error.
+template<typename T, class Codec = MemcpyCodec<T>>
+class SpillQueue{
+public:
+    using size_type = std::size_t;
+
+    explicit SpillQueue(SpillOptions options = SpillOptions(), Codec codec = Codec());
+    ~SpillQueue();
+
+    SpillQueue(const SpillQueue&) = delete;
+    SpillQueue& operator=(const SpillQueue&) = delete;
+
+    template<class U>
+    void push(U&& u);
+
+    void pop();
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    size_type size() const;
+    bool empty() const;
+
+    // Bytes of elements in RAM, counting sizeof(T) each
+    size_type memoryBytes() const;
+    size_type spilledSegments() const;
+    size_type segmentCapacity() const;
+
+private:
+    static constexpr bool kRaw = std::is_same_v<Codec, MemcpyCodec<T>>;
+
+    struct Segment {
+        T* data = nullptr;                  // segmentCapacity() slots, nullptr while spilled
+        size_type begin = 0;                // first live slot
+        size_type end = 0;                  // one past the last live slot
+        std::string path;                   // its file while spilled
+
+        size_type count() const noexcept { return end - begin; }
+    };
+
+    T* acquire();
+    void release(T* data) noexcept;
+    void destroy(Segment& segment) noexcept;
+
+    // Writes a segment to a new file and returns its path; the segment is
+    // left as it was
+    std::string spill(const Segment& segment);
+
+    // The in-memory version of a middle segment; does not change it
+    Segment load(const Segment& segment);
+
+    // Starts the kernel reading the next segment if it is on disk
+    void adviseNext() const noexcept;
+
+    void seal();
+    const std::string& directory();
+
+private:
+    SpillOptions options_;
+    Codec codec_;
+    size_type capacity_;                    // elements per segment
+    Segment head_;
+    Queue<Segment> middle_;
+    Segment tail_;
+    T* spare_ = nullptr;                    // a released buffer kept for the next segment
+    size_type size_ = 0;
+    size_type inMemory_ = 0;                // elements in RAM
+    size_type spilled_ = 0;
+    size_type files_ = 0;                   // segment files ever written, to name them
+    std::string directory_;                 // created by the first spill
+    std::vector<unsigned char> buffer_;     // encoding scratch space for a codec
+};
+
+namespace detail {
+
+[[noreturn]] inline void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+inline void writeAll(int fd, const void* data, std::size_t n) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    while (n > 0) {
+        ssize_t written = ::write(fd, p, n);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("SpillQueue: write");
+        }
+        p += written;
+        n -= static_cast<std::size_t>(written);
+    }
+}
+
+inline void readAll(int fd, void* data, std::size_t n) {
+    auto* p = static_cast<unsigned char*>(data);
+    while (n > 0) {
+        ssize_t got = ::read(fd, p, n);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("SpillQueue: read");
+        }
+        if (got == 0) {
+            errno = EIO;
+            throwErrno("SpillQueue: segment file truncated");
+        }
+        p += got;
+        n -= static_cast<std::size_t>(got);
+    }
+}
+
+// Closes a file descriptor when it goes out of scope
+class FileHandle {
+public:
+    explicit FileHandle(int fd) noexcept : fd_(fd) {}
+    ~FileHandle() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+
+    int get() const noexcept { return fd_; }
+
+private:
+    int fd_;
+};
+
+} // namespace detail
+
+template<typename T, class Codec>
+SpillQueue<T, Codec>::SpillQueue(SpillOptions options, Codec codec)
+    : options_(std::move(options)), codec_(std::move(codec)),
+      capacity_(options_.segmentBytes / sizeof(T) > 0 ? options_.segmentBytes / sizeof(T) : 1) {}
+
+template<typename T, class Codec>
+SpillQueue<T, Codec>::~SpillQueue() {
+    destroy(head_);
+    while (!middle_.empty()) {
+        destroy(middle_.front());
+        middle_.pop();
+    }
+    destroy(tail_);
+    release(spare_);
+    if (!directory_.empty()) {
+        ::rmdir(directory_.c_str());
+    }
+}
+
+// Fills the head while nothing follows it, then the tail. Sealing may spill
+// and free the tail, so an argument that is back() itself is copied first.
+template<typename T, class Codec>
+template<class U>
+void SpillQueue<T, Codec>::push(U&& u) {
+    if (size_ == 0) {
+        head_.begin = 0;
+        head_.end = 0;
+    }
+    Segment* target = &tail_;
+    if (tail_.count() == 0 && middle_.empty() && head_.end < capacity_) {
+        target = &head_;
+    }
+    if (target->data == nullptr) {
+        target->data = acquire();
+    }
+    if (target->end < capacity_) {
+        ::new (static_cast<void*>(target->data + target->end)) T(std::forward<U>(u));
+    } else {
+        T tmp(std::forward<U>(u));
+        seal();
+        ::new (static_cast<void*>(tail_.data)) T(std::move(tmp));
+    }
+    ++target->end;
+    ++size_;
+    ++inMemory_;
+}
+
+// The next segment is loaded before anything changes, so a failed read
+// leaves the queue as it was
+template<typename T, class Codec>
+void SpillQueue<T, Codec>::pop() {
+    assert(!empty() && "Queue is empty");
+    if (head_.count() == 1 && !middle_.empty()) {
+        Segment next = load(middle_.front());
+        if (!middle_.front().path.empty()) {
+            ::unlink(middle_.front().path.c_str());
+            --spilled_;
+        }
+        middle_.pop();
+        destroy(head_);
+        head_ = std::move(next);
+        adviseNext();
+    } else {
+        std::destroy_at(head_.data + head_.begin);
+        ++head_.begin;
+        if (head_.count() == 0 && tail_.count() > 0) {
+            std::swap(head_, tail_);
+            tail_.begin = 0;
+            tail_.end = 0;
+        }
+    }
+    --size_;
+    --inMemory_;
+}
+
+template<typename T, class Codec>
+T& SpillQueue<T, Codec>::front() {
+    assert(!empty() && "Queue is empty");
+    return head_.data[head_.begin];
+}
+
+template<typename T, class Codec>
+const T& SpillQueue<T, Codec>::front() const {
+    assert(!empty() && "Queue is empty");
+    return head_.data[head_.begin];
+}
+
+template<typename T, class Codec>
+T& SpillQueue<T, Codec>::back() {
+    assert(!empty() && "Queue is empty");
+    const Segment& last = tail_.count() > 0 ? tail_ : head_;
+    return last.data[last.end - 1];
+}
+
+template<typename T, class Codec>
+const T& SpillQueue<T, Codec>::back() const {
+    assert(!empty() && "Queue is empty");
+    const Segment& last = tail_.count() > 0 ? tail_ : head_;
+    return last.data[last.end - 1];
+}
+
+template<typename T, class Codec>
+typename SpillQueue<T, Codec>::size_type SpillQueue<T, Codec>::size() const {
+    return size_;
+}
+
+template<typename T, class Codec>
+bool SpillQueue<T, Codec>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, class Codec>
+typename SpillQueue<T, Codec>::size_type SpillQueue<T, Codec>::memoryBytes() const {
+    return inMemory_ * sizeof(T);
+}
+
+template<typename T, class Codec>
+typename SpillQueue<T, Codec>::size_type SpillQueue<T, Codec>::spilledSegments() const {
+    return spilled_;
+}
+
+template<typename T, class Codec>
+typename SpillQueue<T, Codec>::size_type SpillQueue<T, Codec>::segmentCapacity() const {
+    return capacity_;
+}
+
+template<typename T, class Codec>
+T* SpillQueue<T, Codec>::acquire() {
+    T* data = spare_;
+    if (data != nullptr) {
+        spare_ = nullptr;
+        return data;
+    }
+    return std::allocator<T>().allocate(capacity_);
+}
+
+template<typename T, class Codec>
+void SpillQueue<T, Codec>::release(T* data) noexcept {
+    if (data == nullptr) {
+        return;
+    }
+    if (spare_ == nullptr) {
+        spare_ = data;
+    } else {
+        std::allocator<T>().deallocate(data, capacity_);
+    }
+}
+
+// Frees what a segment holds: its elements and buffer, or its file
+template<typename T, class Codec>
+void SpillQueue<T, Codec>::destroy(Segment& segment) noexcept {
+    if (segment.data != nullptr) {
+        std::destroy(segment.data + segment.begin, segment.data + segment.end);
+        release(segment.data);
+    } else if (!segment.path.empty()) {
+        ::unlink(segment.path.c_str());
+    }
+    segment = Segment();
+}
+
+template<typename T, class Codec>
+std::string SpillQueue<T, Codec>::spill(const Segment& segment) {
+    std::string path = directory() + "/" + std::to_string(files_) + ".seg";
+    detail::FileHandle file(::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600));
+    if (file.get() < 0) {
+        detail::throwErrno("SpillQueue: cannot create segment file");
+    }
+    ++files_;
+    try {
+        if constexpr (kRaw) {
+            detail::writeAll(file.get(), segment.data + segment.begin, segment.count() * sizeof(T));
+        } else {
+            buffer_.clear();
+            for (size_type i = segment.begin; i < segment.end; ++i) {
+                codec_.encode(segment.data[i], buffer_);
+            }
+            detail::writeAll(file.get(), buffer_.data(), buffer_.size());
+        }
+    } catch (...) {
+        ::unlink(path.c_str());
+        throw;
+    }
+    return path;
+}
+
+template<typename T, class Codec>
+typename SpillQueue<T, Codec>::Segment SpillQueue<T, Codec>::load(const Segment& segment) {
+    if (segment.data != nullptr) {
+        return segment;
+    }
+
+    detail::FileHandle file(::open(segment.path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file.get() < 0) {
+        detail::throwErrno("SpillQueue: cannot open segment file");
+    }
+    ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    Segment loaded;
+    loaded.data = acquire();
+    size_type constructed = 0;
+    try {
+        if constexpr (kRaw) {
+            detail::readAll(file.get(), loaded.data, segment.count() * sizeof(T));
+            constructed = segment.count();
+        } else {
+            struct stat info;
+            if (::fstat(file.get(), &info) != 0) {
+                detail::throwErrno("SpillQueue: fstat");
+            }
+            buffer_.resize(static_cast<size_type>(info.st_size));
+            detail::readAll(file.get(), buffer_.data(), buffer_.size());
+            const unsigned char* in = buffer_.data();
+            for (; constructed < segment.count(); ++constructed) {
+                ::new (static_cast<void*>(loaded.data + constructed)) T(codec_.decode(in));
+            }
+        }
+    } catch (...) {
+        std::destroy(loaded.data, loaded.data + constructed);
+        release(loaded.data);
+        throw;
+    }
+    loaded.end = constructed;
+    inMemory_ += constructed;
+    return loaded;
+}
+
+template<typename T, class Codec>
+void SpillQueue<T, Codec>::adviseNext() const noexcept {
+    if (middle_.empty() || middle_.front().path.empty()) {
+        return;
+    }
+    detail::FileHandle file(::open(middle_.front().path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file.get() >= 0) {
+        ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_WILLNEED);
+    }
+}
+
+// Moves the full tail into the middle, spilling it when over budget, and
+// starts a new tail. The file, the new buffer and the middle's slot all come
+// first and the rest cannot fail, so a failed seal leaves the queue as it was.
+template<typename T, class Codec>
+void SpillQueue<T, Codec>::seal() {
+    std::string path;
+    if (inMemory_ * sizeof(T) > options_.memoryBudget) {
+        path = spill(tail_);
+    }
+    T* data = nullptr;
+    bool first = middle_.empty();
+    try {
+        data = acquire();
+        middle_.push(tail_);
+    } catch (...) {
+        release(data);
+        if (!path.empty()) {
+            ::unlink(path.c_str());
+        }
+        throw;
+    }
+
+    if (!path.empty()) {
+        Segment& sealed = middle_.back();
+        size_type count = sealed.count();
+        destroy(sealed);
+        sealed.end = count;
+        sealed.path = std::move(path);
+        inMemory_ -= count;
+        ++spilled_;
+    }
+    tail_ = Segment();
+    tail_.data = data;
+    if (first) {
+        adviseNext();                       // No head change will advise it
+    }
+}
+
+template<typename T, class Codec>
+const std::string& SpillQueue<T, Codec>::directory() {
+    if (directory_.empty()) {
+        std::string base = options_.directory.empty()
+            ? std::filesystem::temp_directory_path().string()
+            : options_.directory;
+        std::string pattern = base + "/ds-spill-XXXXXX";
+        if (::mkdtemp(pattern.data()) == nullptr) {
+            detail::throwErrno("SpillQueue: cannot create spill directory");
+        }
+        directory_ = std::move(pattern);
+    }
+    return directory_;
+}
+
+}
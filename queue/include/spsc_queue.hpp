@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ds {
+
+// SpscQueue: a bounded lock-free FIFO queue for exactly one producer thread
+// and one consumer thread.
+//
+// The buffer is allocated once, by the constructor, and rounded up to a
+// power of two. Indices only ever grow; the slot of index i is i & mask.
+// The producer owns tail_ and the consumer owns head_, each on its own cache
+// line. Each side also keeps a private copy of the other side's index and
+// reloads it only when the copy says the queue is full (producer) or empty
+// (consumer), so in steady state neither thread touches the other's line.
+// The batch operations publish a whole batch with one store.
+template<typename T>
+class SpscQueue{
+public:
+    using size_type = std::size_t;
+
+    explicit SpscQueue(size_type capacity);
+    ~SpscQueue();
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. Returns false, leaving value untouched, if the queue is full.
+    template<class U>
+    bool tryPush(U&& value);
+
+    // Producer only. Copies as many of items[0, count) as fit, in order,
+    // and returns how many that was.
+    size_type tryPushN(const T* items, size_type count);
+
+    // Consumer only. Returns false if the queue is empty.
+    bool tryPop(T& out);
+
+    // Consumer only. Moves up to count elements into out[0, count) and
+    // returns how many it moved.
+    size_type tryPopN(T* out, size_type count);
+
+    // Snapshots, exact only from a thread that neither side is racing with
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    size_type capacity() const noexcept;
+
+private:
+    static constexpr size_type kCacheLine = 64;
+
+    T* slot(size_type index) const noexcept { return data_ + (index & mask_); }
+
+    // Free slots as the producer sees them, reloading head_ if fewer than wanted
+    size_type freeSlots(size_type tail, size_type wanted) noexcept;
+
+    // Filled slots as the consumer sees them, reloading tail_ if fewer than wanted
+    size_type filledSlots(size_type head, size_type wanted) noexcept;
+
+private:
+    // Producer's line
+    alignas(kCacheLine) std::atomic<size_type> tail_{0};
+    size_type cachedHead_ = 0;
+
+    // Consumer's line
+    alignas(kCacheLine) std::atomic<size_type> head_{0};
+    size_type cachedTail_ = 0;
+
+    // Read-only after construction, shared by both
+    alignas(kCacheLine) T* data_ = nullptr;
+    size_type mask_ = 0;
+};
+
+template<typename T>
+SpscQueue<T>::SpscQueue(size_type capacity) {
+    size_type rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    data_ = std::allocator<T>().allocate(rounded);
+    mask_ = rounded - 1;
+}
+
+template<typename T>
+SpscQueue<T>::~SpscQueue() {
+    size_type tail = tail_.load(std::memory_order_acquire);
+    for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+        std::destroy_at(slot(i));
+    }
+    std::allocator<T>().deallocate(data_, mask_ + 1);
+}
+
+template<typename T>
+template<class U>
+bool SpscQueue<T>::tryPush(U&& value) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (freeSlots(tail, 1) == 0) {
+        return false;
+    }
+    ::new (static_cast<void*>(slot(tail))) T(std::forward<U>(value));
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// If a copy throws, the elements already copied are published and the
+// exception propagates
+template<typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::tryPushN(const T* items, size_type count) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type free = freeSlots(tail, count);
+    size_type n = count < free ? count : free;
+
+    size_type done = 0;
+    try {
+        for (; done < n; ++done) {
+            ::new (static_cast<void*>(slot(tail + done))) T(items[done]);
+        }
+    } catch (...) {
+        tail_.store(tail + done, std::memory_order_release);
+        throw;
+    }
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+template<typename T>
+bool SpscQueue<T>::tryPop(T& out) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (filledSlots(head, 1) == 0) {
+        return false;
+    }
+    T* item = slot(head);
+    out = std::move(*item);
+    std::destroy_at(item);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::tryPopN(T* out, size_type count) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type filled = filledSlots(head, count);
+    size_type n = count < filled ? count : filled;
+
+    size_type done = 0;
+    try {
+        for (; done < n; ++done) {
+            T* item = slot(head + done);
+            out[done] = std::move(*item);
+            std::destroy_at(item);
+        }
+    } catch (...) {
+        head_.store(head + done, std::memory_order_release);
+        throw;
+    }
+    head_.store(head + n, std::memory_order_release);
+    return n;
+}
+
+template<typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::size() const noexcept {
+    size_type head = head_.load(std::memory_order_acquire);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template<typename T>
+bool SpscQueue<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template<typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::capacity() const noexcept {
+    return mask_ + 1;
+}
+
+// Acquire on head_ makes sure the consumer is done with a slot before the
+// producer reuses it
+template<typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::freeSlots(size_type tail, size_type wanted) noexcept {
+    size_type free = capacity() - (tail - cachedHead_);
+    if (free < wanted) {
+        cachedHead_ = head_.load(std::memory_order_acquire);
+        free = capacity() - (tail - cachedHead_);
+    }
+    return free;
+}
+
+// Acquire on tail_ makes the producer's writes to the slots visible
+template<typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::filledSlots(size_type head, size_type wanted) noexcept {
+    size_type filled = cachedTail_ - head;
+    if (filled < wanted) {
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        filled = cachedTail_ - head;
+    }
+    return filled;
+}
+
+}
@@ -0,0 +1,209 @@
+// test_async_queue.cpp
+// Catch2 unit tests for template class AsyncQueue<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "async_queue.hpp"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ds::AsyncQueue;
+
+namespace {
+
+// A coroutine that starts at once and frees itself when it finishes
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+// Holds resumptions until run() is called, like an event loop
+class ManualExecutor : public ds::Executor {
+public:
+    void execute(std::coroutine_handle<> handle) override { pending_.push_back(handle); }
+
+    std::size_t run() {
+        std::vector<std::coroutine_handle<>> batch;
+        batch.swap(pending_);
+        for (auto handle : batch) {
+            handle.resume();
+        }
+        return batch.size();
+    }
+
+private:
+    std::vector<std::coroutine_handle<>> pending_;
+};
+
+// Pops until the queue is closed, recording what it gets
+Detached consume(AsyncQueue<std::string>& q, std::vector<std::string>& got, bool& done) {
+    while (auto value = co_await q.pop()) {
+        got.push_back(*value);
+    }
+    done = true;
+}
+
+Detached consumeBatches(AsyncQueue<int>& q, std::vector<std::vector<int>>& batches) {
+    int out[3];
+    while (auto n = co_await q.popN(out, 3)) {
+        batches.emplace_back(out, out + n);
+    }
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// pop
+// -----------------------------------------------------------------------------
+TEST_CASE("pop completes at once when an element is there", "[pop]") {
+    AsyncQueue<std::string> q;
+    REQUIRE(q.push("a"));
+    REQUIRE(q.size() == 1);
+
+    std::vector<std::string> got;
+    bool done = false;
+    consume(q, got, done);
+    REQUIRE(got == std::vector<std::string>{"a"});   // Ran without any push resuming it
+    REQUIRE(q.empty());
+
+    q.close();
+    REQUIRE(done);
+}
+
+TEST_CASE("push resumes a suspended pop inline by default", "[pop][push]") {
+    AsyncQueue<std::string> q;
+    std::vector<std::string> got;
+    bool done = false;
+    consume(q, got, done);
+    REQUIRE(got.empty());               // Suspended, not blocked: we are back here
+
+    q.push("x");
+    REQUIRE(got == std::vector<std::string>{"x"});
+    REQUIRE(q.empty());                 // Handed over, never queued
+
+    q.push("y");
+    q.close();
+    REQUIRE(got == std::vector<std::string>{"x", "y"});
+    REQUIRE(done);
+    REQUIRE_FALSE(q.push("z"));
+}
+
+TEST_CASE("Waiters resume on the queue's executor in arrival order", "[pop][executor]") {
+    ManualExecutor loop;
+    AsyncQueue<std::string> q(loop);
+    std::vector<std::string> first, second;
+    bool firstDone = false, secondDone = false;
+    consume(q, first, firstDone);
+    consume(q, second, secondDone);
+
+    q.push("1");
+    q.push("2");
+    REQUIRE(first.empty());             // Not resumed until the loop runs
+    REQUIRE(loop.run() == 2);
+    REQUIRE(first == std::vector<std::string>{"1"});
+    REQUIRE(second == std::vector<std::string>{"2"});
+
+    q.close();
+    REQUIRE_FALSE(firstDone);
+    REQUIRE(loop.run() == 2);
+    REQUIRE(firstDone);
+    REQUIRE(secondDone);
+}
+
+TEST_CASE("close lets pops drain what is left", "[close]") {
+    AsyncQueue<std::string> q;
+    q.push("a");
+    q.push("b");
+    q.close();
+    REQUIRE(q.closed());
+
+    std::vector<std::string> got;
+    bool done = false;
+    consume(q, got, done);
+    REQUIRE(got == std::vector<std::string>{"a", "b"});
+    REQUIRE(done);
+
+    std::string out;
+    REQUIRE_FALSE(q.tryPop(out));
+}
+
+// -----------------------------------------------------------------------------
+// Batches
+// -----------------------------------------------------------------------------
+TEST_CASE("popN takes what is queued up to the batch size", "[batch]") {
+    AsyncQueue<int> q;
+    int values[] = {1, 2, 3, 4};
+    REQUIRE(q.pushN(values, 4));
+
+    std::vector<std::vector<int>> batches;
+    consumeBatches(q, batches);
+    REQUIRE(batches.size() == 2);
+    REQUIRE(batches[0] == std::vector<int>{1, 2, 3});
+    REQUIRE(batches[1] == std::vector<int>{4});
+    q.close();
+}
+
+TEST_CASE("pushN fills waiters in order and queues the rest", "[batch]") {
+    AsyncQueue<int> q;
+    std::vector<std::vector<int>> batches;
+    consumeBatches(q, batches);         // Suspends, waiting for up to 3
+    int values[] = {1, 2, 3, 4, 5};
+    REQUIRE(q.pushN(values, 5));
+    // The waiter got the first three; on resuming it took the other two
+    REQUIRE(batches.size() == 2);
+    REQUIRE(batches[0] == std::vector<int>{1, 2, 3});
+    REQUIRE(batches[1] == std::vector<int>{4, 5});
+    REQUIRE(q.empty());
+
+    q.push(6);
+    REQUIRE(batches.back() == std::vector<int>{6});
+
+    q.close();
+    REQUIRE_FALSE(q.pushN(values, 5));
+}
+
+// -----------------------------------------------------------------------------
+// Threads
+// -----------------------------------------------------------------------------
+TEST_CASE("Producers on other threads resume a coroutine", "[thread]") {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+
+    AsyncQueue<int> q;
+    long long sum = 0;
+    bool done = false;
+    auto consumer = [](AsyncQueue<int>& q, long long& sum, bool& done) -> Detached {
+        while (auto value = co_await q.pop()) {
+            sum += *value;
+        }
+        done = true;
+    };
+    consumer(q, sum, done);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                q.push(p * kPerProducer + i);
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    q.close();
+
+    long long total = static_cast<long long>(kProducers) * kPerProducer;
+    REQUIRE(done);
+    REQUIRE(sum == total * (total - 1) / 2);
+}
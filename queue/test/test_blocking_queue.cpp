@@ -0,0 +1,141 @@
+// test_blocking_queue.cpp
+// Catch2 unit tests for template class BlockingQueue<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "blocking_queue.hpp"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ds::BlockingQueue;
+using namespace std::chrono_literals;
+
+// -----------------------------------------------------------------------------
+// Single-threaded behaviour
+// -----------------------------------------------------------------------------
+TEST_CASE("BlockingQueue pops in FIFO order", "[push][pop]") {
+    BlockingQueue<std::string> q;
+    REQUIRE(q.empty());
+    REQUIRE(q.push("a"));
+    REQUIRE(q.push(std::string("b")));
+    REQUIRE(q.size() == 2);
+
+    std::string out;
+    REQUIRE(q.pop(out));
+    REQUIRE(out == "a");
+    REQUIRE(q.tryPop(out));
+    REQUIRE(out == "b");
+    REQUIRE_FALSE(q.tryPop(out));
+}
+
+TEST_CASE("pop with a timeout gives up on an empty queue", "[pop][timeout]") {
+    BlockingQueue<int> q;
+    int out = 0;
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE_FALSE(q.pop(out, 20ms));
+    REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+
+    q.push(5);
+    REQUIRE(q.pop(out, 0ms));           // Available at once: no wait needed
+    REQUIRE(out == 5);
+}
+
+TEST_CASE("waitPopN drains up to a batch at a time", "[batch]") {
+    BlockingQueue<int> q;
+    for (int i = 0; i < 10; ++i) {
+        q.push(i);
+    }
+    int batch[4];
+    REQUIRE(q.waitPopN(batch, 4) == 4);
+    REQUIRE(batch[0] == 0);
+    REQUIRE(batch[3] == 3);
+    REQUIRE(q.waitPopN(batch, 4) == 4);
+    REQUIRE(q.waitPopN(batch, 4) == 2);
+    REQUIRE(batch[1] == 9);
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("close rejects pushes and lets consumers drain", "[close]") {
+    BlockingQueue<int> q;
+    q.push(1);
+    q.push(2);
+    q.close();
+    REQUIRE(q.closed());
+    REQUIRE_FALSE(q.push(3));
+
+    int out = 0;
+    REQUIRE(q.pop(out));
+    REQUIRE(out == 1);
+    int batch[4];
+    REQUIRE(q.waitPopN(batch, 4) == 1);
+    REQUIRE(batch[0] == 2);
+    REQUIRE_FALSE(q.pop(out));          // Closed and empty: returns at once
+    REQUIRE(q.waitPopN(batch, 4) == 0);
+}
+
+// -----------------------------------------------------------------------------
+// Waiting threads
+// -----------------------------------------------------------------------------
+TEST_CASE("a parked consumer wakes for a push and for close", "[thread][close]") {
+    BlockingQueue<int> q;
+    std::vector<int> received;
+
+    std::thread consumer([&] {
+        int out = 0;
+        while (q.pop(out)) {
+            received.push_back(out);
+        }
+    });
+
+    std::this_thread::sleep_for(10ms);  // Let the consumer park
+    q.push(1);
+    std::this_thread::sleep_for(10ms);
+    q.push(2);
+    q.push(3);
+    q.close();
+    consumer.join();
+
+    REQUIRE(received == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("many producers and batch consumers lose nothing", "[thread][batch]") {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+
+    BlockingQueue<int> q;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                q.push(p * kPerProducer + i);
+            }
+        });
+    }
+
+    long long sums[2] = {0, 0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&, c] {
+            int batch[32];
+            while (auto n = q.waitPopN(batch, 32)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    sums[c] += batch[i];
+                }
+            }
+        });
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    q.close();
+    for (auto& t : consumers) {
+        t.join();
+    }
+
+    long long total = static_cast<long long>(kProducers) * kPerProducer;
+    REQUIRE(sums[0] + sums[1] == total * (total - 1) / 2);
+}
@@ -0,0 +1,159 @@
+// test_chunked_queue.cpp
+// Catch2 unit tests for template class ChunkedQueue<T, BlockBytes>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "chunked_queue.hpp"
+#include <stdexcept>
+#include <string>
+
+using ds::ChunkedQueue;
+
+namespace {
+
+// Small blocks so that a few pushes cross block boundaries
+using SmallQueue = ChunkedQueue<int, 64>;
+
+struct Throwing {
+    static int budget;                  // Copies allowed before one throws
+    int value;
+
+    explicit Throwing(int v) : value(v) {}
+    Throwing(const Throwing& other) : value(other.value) {
+        if (--budget < 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+};
+
+int Throwing::budget = 0;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// push / pop / front / back
+// -----------------------------------------------------------------------------
+TEST_CASE("Default-constructed chunked queue is empty and holds no block", "[constructor]") {
+    ChunkedQueue<int> q;
+    REQUIRE(q.empty());
+    REQUIRE(q.size() == 0);
+    REQUIRE(q.blockCount() == 0);
+}
+
+TEST_CASE("Elements come out in FIFO order across blocks", "[push][pop]") {
+    SmallQueue q;
+    REQUIRE(SmallQueue::blockCapacity() > 1);
+    const int n = static_cast<int>(SmallQueue::blockCapacity()) * 5 + 3;
+    for (int i = 0; i < n; ++i) {
+        q.push(i);
+        REQUIRE(q.back() == i);
+    }
+    REQUIRE(q.size() == static_cast<std::size_t>(n));
+    REQUIRE(q.blockCount() == 6);
+
+    for (int i = 0; i < n; ++i) {
+        REQUIRE(q.front() == i);
+        q.pop();
+    }
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("References stay valid while the queue grows", "[push][reference]") {
+    SmallQueue q;
+    q.push(7);
+    const int& first = q.front();
+    for (int i = 0; i < 1000; ++i) {
+        q.push(i);
+    }
+    REQUIRE(&first == &q.front());
+    REQUIRE(first == 7);
+}
+
+TEST_CASE("push of an element of the queue itself", "[push][alias]") {
+    ChunkedQueue<std::string, 64> q;
+    q.push("a");
+    for (int i = 0; i < 20; ++i) {
+        q.push(q.front());
+    }
+    REQUIRE(q.size() == 21);
+    REQUIRE(q.back() == "a");
+}
+
+// -----------------------------------------------------------------------------
+// Block recycling
+// -----------------------------------------------------------------------------
+TEST_CASE("Steady churn recycles blocks instead of allocating", "[recycle]") {
+    SmallQueue q;
+    const std::size_t window = SmallQueue::blockCapacity() * 3;
+    for (std::size_t i = 0; i < window; ++i) {
+        q.push(static_cast<int>(i));
+    }
+    for (std::size_t i = 0; i < 100 * window; ++i) {
+        q.push(static_cast<int>(i));
+        q.pop();
+        REQUIRE(q.blockCount() <= 5);   // Window blocks, one partly drained, the spare
+    }
+    REQUIRE(q.size() == window);
+}
+
+TEST_CASE("Draining frees all but one block and the spare", "[recycle]") {
+    SmallQueue q;
+    for (int i = 0; i < 1000; ++i) {
+        q.push(i);
+    }
+    while (!q.empty()) {
+        q.pop();
+    }
+    REQUIRE(q.blockCount() <= 2);
+    q.push(1);
+    REQUIRE(q.front() == 1);
+    REQUIRE(q.back() == 1);
+}
+
+TEST_CASE("Blocks stay close to BlockBytes", "[memory]") {
+    REQUIRE(ChunkedQueue<int>::blockBytes() <= 4096 + alignof(std::max_align_t));
+    REQUIRE(ChunkedQueue<int>::blockCapacity() * sizeof(int) >= 4000);
+}
+
+// -----------------------------------------------------------------------------
+// Copy, move and exceptions
+// -----------------------------------------------------------------------------
+TEST_CASE("Copy and move preserve order", "[copy][move]") {
+    ChunkedQueue<std::string, 128> q;
+    for (int i = 0; i < 100; ++i) {
+        q.push(std::to_string(i));
+    }
+    q.pop();
+
+    ChunkedQueue<std::string, 128> copy = q;
+    REQUIRE(copy.size() == 99);
+    ChunkedQueue<std::string, 128> moved = std::move(q);
+    REQUIRE(q.empty());
+
+    ChunkedQueue<std::string, 128> assigned;
+    assigned = copy;
+    for (int i = 1; i < 100; ++i) {
+        REQUIRE(moved.front() == std::to_string(i));
+        REQUIRE(assigned.front() == std::to_string(i));
+        moved.pop();
+        assigned.pop();
+    }
+    REQUIRE(copy.front() == "1");
+}
+
+TEST_CASE("A throwing push leaves the queue unchanged", "[push][exception]") {
+    using ThrowingQueue = ChunkedQueue<Throwing, 64>;
+    ThrowingQueue q;
+    Throwing::budget = 1000;
+    for (int i = 0; i < 20; ++i) {
+        q.push(Throwing(i));
+    }
+    Throwing::budget = 0;
+    REQUIRE_THROWS_AS(q.push(Throwing(99)), std::runtime_error);
+    REQUIRE(q.size() == 20);
+    REQUIRE(q.back().value == 19);
+
+    Throwing::budget = 10;
+    REQUIRE_THROWS_AS(ThrowingQueue(q), std::runtime_error);
+}
@@ -0,0 +1,137 @@
+// test_mpmc_queue.cpp
+// Catch2 unit tests for template class MpmcQueue<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "mpmc_queue.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ds::MpmcQueue;
+
+// -----------------------------------------------------------------------------
+// Single-threaded behaviour
+// -----------------------------------------------------------------------------
+TEST_CASE("MpmcQueue is FIFO and bounded", "[push][pop][capacity]") {
+    MpmcQueue<int> q(5);
+    REQUIRE(q.capacity() == 8);
+    REQUIRE(q.empty());
+
+    int out = -1;
+    REQUIRE_FALSE(q.tryPop(out));
+
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(q.tryPush(i));
+    }
+    REQUIRE_FALSE(q.tryPush(8));
+    REQUIRE(q.size() == 8);
+
+    for (int i = 0; i < 50; ++i) {      // Several laps
+        REQUIRE(q.tryPop(out));
+        REQUIRE(out == i);
+        REQUIRE(q.tryPush(i + 8));
+    }
+}
+
+TEST_CASE("MpmcQueue destroys the elements it still holds", "[lifetime]") {
+    auto shared = std::make_shared<int>(1);
+    {
+        MpmcQueue<std::shared_ptr<int>> q(4);
+        for (int i = 0; i < 3; ++i) {
+            q.tryPush(shared);
+        }
+        std::shared_ptr<int> out;
+        REQUIRE(q.tryPop(out));
+        out.reset();
+        REQUIRE(shared.use_count() == 3);
+    }
+    REQUIRE(shared.use_count() == 1);
+}
+
+// -----------------------------------------------------------------------------
+// Many producers and consumers
+// -----------------------------------------------------------------------------
+TEST_CASE("every message is delivered exactly once", "[thread]") {
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerProducer = 25000;
+    constexpr int kTotal = kProducers * kPerProducer;
+
+    MpmcQueue<std::string> q(64);
+    std::vector<std::atomic<int>> received(kTotal);
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                std::string message = std::to_string(p * kPerProducer + i);
+                while (!q.tryPush(message)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            std::string message;
+            while (consumed.load() < kTotal) {
+                if (q.tryPop(message)) {
+                    received[std::stoi(message)].fetch_add(1);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int wrong = 0;
+    for (auto& count : received) {
+        wrong += count.load() != 1;
+    }
+    REQUIRE(wrong == 0);
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("each producer's messages arrive in order", "[thread][order]") {
+    constexpr int kPerProducer = 50000;
+    MpmcQueue<int> q(16);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!q.tryPush(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // With a single consumer, FIFO means each producer's values come in order
+    int last[2] = {-1, kPerProducer - 1};
+    int outOfOrder = 0;
+    int value = 0;
+    for (int received = 0; received < 2 * kPerProducer;) {
+        if (q.tryPop(value)) {
+            int p = value / kPerProducer;
+            outOfOrder += value <= last[p];
+            last[p] = value;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    REQUIRE(outOfOrder == 0);
+}
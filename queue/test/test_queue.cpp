@@ -140,4 +140,93 @@ TEST_CASE("Queue supports move semantics in push", "[push][move]") {
     q.push(std::string("world"));
     REQUIRE(q.back() == "world");
     REQUIRE(q.size() == 2);
-}
\ No newline at end of file
+}
+
+// -----------------------------------------------------------------------------
+// Circular buffer
+// -----------------------------------------------------------------------------
+TEST_CASE("Queue wraps around its buffer without growing", "[ring][wrap]") {
+    Queue<int> q;
+    REQUIRE(q.capacity() == 0);     // No allocation until the first push
+
+    q.push(0);
+    const auto capacity = q.capacity();
+    REQUIRE(capacity >= 1);
+    REQUIRE((capacity & (capacity - 1)) == 0);
+
+    // Keep the queue half full while head and tail circle the buffer
+    int next = 1;
+    for (int round = 0; round < 10 * static_cast<int>(capacity); ++round) {
+        q.push(next++);
+        if (q.size() > capacity / 2) {
+            q.pop();
+        }
+    }
+    REQUIRE(q.capacity() == capacity);
+    REQUIRE(q.back() == next - 1);
+    REQUIRE(q.front() == next - static_cast<int>(q.size()));
+}
+
+TEST_CASE("Queue keeps FIFO order when it grows while wrapped", "[ring][grow]") {
+    Queue<std::string> q;
+    int pushed = 0;
+    int popped = 0;
+    for (int i = 0; i < 6; ++i) {
+        q.push(std::to_string(pushed++));
+    }
+    for (int i = 0; i < 4; ++i) {       // Moves head into the buffer
+        REQUIRE(q.front() == std::to_string(popped++));
+        q.pop();
+    }
+    for (int i = 0; i < 100; ++i) {     // Wraps, then grows several times
+        q.push(std::to_string(pushed++));
+    }
+
+    Queue<std::string> copy = q;
+    while (!q.empty()) {
+        REQUIRE(q.front() == std::to_string(popped++));
+        q.pop();
+    }
+    REQUIRE(popped == pushed);
+    REQUIRE(copy.size() == 102);
+    REQUIRE(copy.front() == "4");
+    REQUIRE(copy.back() == std::to_string(pushed - 1));
+}
+
+TEST_CASE("push may copy an element of the same queue", "[push][alias]") {
+    Queue<std::string> q;
+    q.push(std::string(40, 'a'));
+    while (q.size() < q.capacity()) {
+        q.push(std::string(40, 'b'));
+    }
+    q.push(q.front());                  // Full: the argument is copied before growing
+    REQUIRE(q.back() == std::string(40, 'a'));
+}
+
+TEST_CASE("Queue destroys every element it constructs", "[lifetime]") {
+    static int live = 0;
+    struct Tracked {
+        Tracked() { ++live; }
+        Tracked(const Tracked&) { ++live; }
+        ~Tracked() { --live; }
+    };
+
+    {
+        Queue<Tracked> q;
+        for (int i = 0; i < 20; ++i) {
+            q.push(Tracked());
+            if (i % 3 == 0) {
+                q.pop();
+            }
+        }
+        Queue<Tracked> copy = q;
+        REQUIRE(live == 2 * 13);
+    }
+    REQUIRE(live == 0);
+
+    Queue<std::string> moved;
+    moved.push("x");
+    Queue<std::string> target = std::move(moved);
+    moved.push("reused");               // A moved-from queue is empty and usable
+    REQUIRE(moved.front() == "reused");
+}
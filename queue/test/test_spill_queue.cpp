@@ -0,0 +1,187 @@
+// test_spill_queue.cpp
+// Catch2 unit tests for template class SpillQueue<T, Codec>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "spill_queue.hpp"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using ds::SpillOptions;
+using ds::SpillQueue;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// A fresh directory for one test's segment files, removed afterwards
+class ScratchDir {
+public:
+    ScratchDir() {
+        std::string pattern = (fs::temp_directory_path() / "test-spill-XXXXXX").string();
+        REQUIRE(::mkdtemp(pattern.data()) != nullptr);
+        path_ = pattern;
+    }
+    ~ScratchDir() { fs::remove_all(path_); }
+
+    const std::string& path() const { return path_; }
+
+    // Files and directories anywhere below
+    std::size_t entries() const {
+        std::size_t n = 0;
+        for (auto it = fs::recursive_directory_iterator(path_); it != fs::recursive_directory_iterator(); ++it) {
+            ++n;
+        }
+        return n;
+    }
+
+private:
+    std::string path_;
+};
+
+// Small segments and budget so that a few thousand ints spill
+SpillOptions smallOptions(const ScratchDir& dir) {
+    SpillOptions options;
+    options.segmentBytes = 256 * sizeof(std::uint32_t);
+    options.memoryBudget = 4 * options.segmentBytes;
+    options.directory = dir.path();
+    return options;
+}
+
+// Length-prefixed strings
+struct StringCodec {
+    void encode(const std::string& value, std::vector<unsigned char>& out) const {
+        std::uint32_t length = static_cast<std::uint32_t>(value.size());
+        const auto* prefix = reinterpret_cast<const unsigned char*>(&length);
+        out.insert(out.end(), prefix, prefix + sizeof(length));
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+    std::string decode(const unsigned char*& in) const {
+        std::uint32_t length = 0;
+        std::memcpy(&length, in, sizeof(length));
+        in += sizeof(length);
+        std::string value(reinterpret_cast<const char*>(in), length);
+        in += length;
+        return value;
+    }
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// In memory
+// -----------------------------------------------------------------------------
+TEST_CASE("Under its budget the queue stays in memory", "[memory]") {
+    ScratchDir dir;
+    SpillQueue<std::uint32_t> q(smallOptions(dir));
+    REQUIRE(q.empty());
+    for (std::uint32_t i = 0; i < 600; ++i) {
+        q.push(i);
+        REQUIRE(q.back() == i);
+    }
+    REQUIRE(q.spilledSegments() == 0);
+    REQUIRE(dir.entries() == 0);        // Not even the spill directory
+
+    for (std::uint32_t i = 0; i < 600; ++i) {
+        REQUIRE(q.front() == i);
+        q.pop();
+    }
+    REQUIRE(q.empty());
+    REQUIRE(q.memoryBytes() == 0);
+}
+
+// -----------------------------------------------------------------------------
+// Spilling
+// -----------------------------------------------------------------------------
+TEST_CASE("A burst spills the middle and reads it back in order", "[spill]") {
+    ScratchDir dir;
+    SpillOptions options = smallOptions(dir);
+    {
+        SpillQueue<std::uint32_t> q(options);
+        const std::uint32_t n = 100000;
+        for (std::uint32_t i = 0; i < n; ++i) {
+            q.push(i);
+            REQUIRE(q.memoryBytes() <= options.memoryBudget + 2 * options.segmentBytes);
+        }
+        REQUIRE(q.size() == n);
+        REQUIRE(q.spilledSegments() > 300);
+        REQUIRE(q.front() == 0);
+        REQUIRE(q.back() == n - 1);
+
+        for (std::uint32_t i = 0; i < n; ++i) {
+            REQUIRE(q.front() == i);
+            q.pop();
+            REQUIRE(q.memoryBytes() <= options.memoryBudget + 2 * options.segmentBytes);
+        }
+        REQUIRE(q.empty());
+        REQUIRE(q.spilledSegments() == 0);
+        REQUIRE(dir.entries() == 1);    // The spill directory, emptied
+    }
+    REQUIRE(dir.entries() == 0);
+}
+
+TEST_CASE("Pushes and pops interleave while spilled", "[spill]") {
+    ScratchDir dir;
+    std::uint32_t pushed = 0;
+    std::uint32_t popped = 0;
+    {
+        SpillQueue<std::uint32_t> q(smallOptions(dir));
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 3000; ++i) {
+                q.push(pushed++);
+            }
+            for (int i = 0; i < 2000; ++i) {
+                REQUIRE(q.front() == popped++);
+                q.pop();
+            }
+        }
+        REQUIRE(q.size() == pushed - popped);
+        q.push(q.back());               // An element of the queue itself, on a full tail
+        REQUIRE(q.back() == pushed - 1);
+    }                                   // Destroyed while spilled
+    REQUIRE(dir.entries() == 0);
+}
+
+TEST_CASE("A user codec spills other types", "[spill][codec]") {
+    ScratchDir dir;
+    SpillOptions options;
+    options.segmentBytes = 16 * sizeof(std::string);
+    options.memoryBudget = 2 * options.segmentBytes;
+    options.directory = dir.path();
+
+    SpillQueue<std::string, StringCodec> q(options);
+    for (int i = 0; i < 1000; ++i) {
+        q.push(std::string(static_cast<std::size_t>(i % 50), 'x') + std::to_string(i));
+    }
+    REQUIRE(q.spilledSegments() > 0);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(q.front() == std::string(static_cast<std::size_t>(i % 50), 'x') + std::to_string(i));
+        q.pop();
+    }
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("A failed spill throws and keeps the queue intact", "[spill][error]") {
+    SpillOptions options;
+    options.segmentBytes = 16 * sizeof(std::uint32_t);
+    options.memoryBudget = 0;
+    options.directory = "/nonexistent/ds-spill-test";
+
+    SpillQueue<std::uint32_t> q(options);
+    for (std::uint32_t i = 0; i < 32; ++i) {
+        q.push(i);                      // Head and tail: no spill yet
+    }
+    REQUIRE_THROWS_AS(q.push(32u), std::system_error);
+    REQUIRE(q.size() == 32);
+    REQUIRE(q.back() == 31);
+    for (std::uint32_t i = 0; i < 32; ++i) {
+        REQUIRE(q.front() == i);
+        q.pop();
+    }
+}
@@ -0,0 +1,162 @@
+// test_spsc_queue.cpp
+// Catch2 unit tests for template class SpscQueue<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "spsc_queue.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ds::SpscQueue;
+
+namespace {
+
+// Counts live objects; a move assignment throws once the budget runs out
+struct Tracked {
+    static int live;
+    static int budget;
+    int value = 0;
+
+    Tracked() { ++live; }
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(Tracked&& other) {
+        if (--budget < 0) {
+            throw std::runtime_error("move");
+        }
+        value = other.value;
+        return *this;
+    }
+    ~Tracked() { --live; }
+};
+
+int Tracked::live = 0;
+int Tracked::budget = 0;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Single-threaded behaviour
+// -----------------------------------------------------------------------------
+TEST_CASE("SpscQueue is FIFO and bounded", "[push][pop][capacity]") {
+    SpscQueue<int> q(3);
+    REQUIRE(q.capacity() == 4);         // Rounded up to a power of two
+    REQUIRE(q.empty());
+
+    int out = -1;
+    REQUIRE_FALSE(q.tryPop(out));
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(q.tryPush(i));
+    }
+    REQUIRE_FALSE(q.tryPush(4));
+    REQUIRE(q.size() == 4);
+
+    // Many laps around the buffer
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(q.tryPop(out));
+        REQUIRE(out == i);
+        REQUIRE(q.tryPush(i + 4));
+    }
+    REQUIRE(q.size() == 4);
+}
+
+TEST_CASE("batches transfer as many elements as fit", "[batch]") {
+    SpscQueue<std::string> q(8);
+    std::vector<std::string> items;
+    for (int i = 0; i < 12; ++i) {
+        items.push_back(std::to_string(i));
+    }
+
+    REQUIRE(q.tryPushN(items.data(), 5) == 5);
+    REQUIRE(q.tryPushN(items.data() + 5, 7) == 3);   // Only 3 slots left
+    REQUIRE(q.tryPushN(items.data() + 8, 4) == 0);
+
+    std::vector<std::string> out(6);
+    REQUIRE(q.tryPopN(out.data(), 6) == 6);
+    REQUIRE(out[0] == "0");
+    REQUIRE(out[5] == "5");
+
+    REQUIRE(q.tryPushN(items.data() + 8, 4) == 4);   // Wraps around
+    REQUIRE(q.tryPopN(out.data(), 6) == 6);
+    REQUIRE(out[0] == "6");
+    REQUIRE(out[5] == "11");
+    REQUIRE(q.tryPopN(out.data(), 6) == 0);
+}
+
+TEST_CASE("a throwing batch pop keeps the elements it did not take", "[batch][exception]") {
+    {
+        SpscQueue<Tracked> q(8);
+        std::vector<Tracked> items;
+        for (int i = 0; i < 5; ++i) {
+            items.emplace_back(i);
+        }
+        REQUIRE(q.tryPushN(items.data(), 5) == 5);
+
+        std::vector<Tracked> out(5);
+        Tracked::budget = 2;            // The third move throws
+        REQUIRE_THROWS_AS(q.tryPopN(out.data(), 5), std::runtime_error);
+        REQUIRE(q.size() == 3);
+        REQUIRE(out[1].value == 1);
+
+        Tracked::budget = 100;
+        REQUIRE(q.tryPopN(out.data(), 5) == 3);
+        REQUIRE(out[0].value == 2);
+        REQUIRE(out[2].value == 4);
+    }
+    REQUIRE(Tracked::live == 0);        // Nothing destroyed twice, nothing leaked
+}
+
+TEST_CASE("SpscQueue destroys the elements it still holds", "[lifetime]") {
+    auto shared = std::make_shared<int>(1);
+    {
+        SpscQueue<std::shared_ptr<int>> q(4);
+        q.tryPush(shared);
+        q.tryPush(shared);
+        q.tryPush(shared);
+
+        std::shared_ptr<int> out;
+        REQUIRE(q.tryPop(out));
+        out.reset();
+        REQUIRE(shared.use_count() == 3);
+    }
+    REQUIRE(shared.use_count() == 1);
+}
+
+// -----------------------------------------------------------------------------
+// Producer and consumer threads
+// -----------------------------------------------------------------------------
+TEST_CASE("a consumer thread sees every message in order", "[thread]") {
+    constexpr int kMessages = 200000;
+    SpscQueue<std::string> q(64);
+
+    int mismatches = 0;
+    std::thread consumer([&] {
+        std::string batch[16];
+        for (int expected = 0; expected < kMessages;) {
+            auto n = q.tryPopN(batch, 16);
+            for (std::size_t i = 0; i < n; ++i, ++expected) {
+                mismatches += batch[i] != std::to_string(expected);
+            }
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < kMessages; ++i) {
+        std::string message = std::to_string(i);
+        while (!q.tryPush(message)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(q.empty());
+}
@@ -0,0 +1,58 @@
+// bench_cow_seq_list.cpp
+// Handing one list to many readers: a SeqList copy per reader against a
+// CowSeqList snapshot per reader, followed by one write to the original.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "cow_seq_list.hpp"
+#include "seq_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void compare(std::size_t n, std::size_t readers) {
+    ds::SeqList<std::string> plain;
+    ds::CowSeqList<std::string> cow;
+    for (std::size_t i = 0; i < n; ++i) {
+        plain.pushBack("config-key-" + std::to_string(i) + std::string(16, '.'));
+        cow.pushBack("config-key-" + std::to_string(i) + std::string(16, '.'));
+    }
+
+    auto start = Clock::now();
+    {
+        std::vector<ds::SeqList<std::string>> copies(readers, plain);
+        plain.set(0, "updated");
+    }
+    double copied = since(start);
+
+    start = Clock::now();
+    {
+        std::vector<ds::CowSeqList<std::string>::Snapshot> snapshots(readers, cow.snapshot());
+        cow.set(0, "updated");          // One copy, however many readers
+    }
+    double shared = since(start);
+
+    std::printf("n=%-8zu readers=%-4zu SeqList copies %9.4f s   snapshots %9.4f s   x%.1f\n",
+                n, readers, copied, shared, copied / shared);
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t n : {1000u, 100000u}) {
+        for (std::size_t readers : {1u, 8u, 64u}) {
+            compare(n, readers);
+        }
+    }
+    return 0;
+}
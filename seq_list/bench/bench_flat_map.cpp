@@ -0,0 +1,94 @@
+// bench_flat_map.cpp
+// Lookup and build throughput of FlatMap<K, V> against a node-based ordered
+// map (std::map, a red-black tree with the same pointer-chasing layout as
+// AVLTree).
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "flat_map.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename Map>
+std::uint64_t lookups(const Map& map, const std::vector<std::uint64_t>& probes) {
+    std::uint64_t hits = 0;
+    for (std::uint64_t key : probes) {
+        auto it = map.find(key);
+        hits += it != map.end() ? it->second : 0;
+    }
+    return hits;
+}
+
+std::uint64_t lookups(const ds::FlatMap<std::uint64_t, std::uint64_t>& map,
+                      const std::vector<std::uint64_t>& probes) {
+    std::uint64_t hits = 0;
+    for (std::uint64_t key : probes) {
+        const std::uint64_t* value = map.find(key);
+        hits += value != nullptr ? *value : 0;
+    }
+    return hits;
+}
+
+void compare(std::size_t n) {
+    std::mt19937_64 rng(n);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs(n);
+    for (auto& p : pairs) {
+        p = {rng() % (4 * n), rng()};
+    }
+    std::vector<std::uint64_t> probes(2000000);
+    for (auto& key : probes) {
+        key = rng() % (4 * n);
+    }
+
+    auto start = Clock::now();
+    std::map<std::uint64_t, std::uint64_t> tree;
+    for (const auto& p : pairs) {
+        tree[p.first] = p.second;
+    }
+    double treeBuild = seconds(start);
+
+    start = Clock::now();
+    ds::FlatMap<std::uint64_t, std::uint64_t> flat(pairs.begin(), pairs.end());
+    double flatBuild = seconds(start);
+
+    start = Clock::now();
+    std::uint64_t treeHits = lookups(tree, probes);
+    double treeFind = seconds(start);
+
+    start = Clock::now();
+    std::uint64_t flatHits = lookups(flat, probes);
+    double flatFind = seconds(start);
+
+    if (treeHits != flatHits) {
+        std::printf("mismatch at n=%zu\n", n);
+    }
+
+    double m = static_cast<double>(probes.size()) / 1e6;
+    std::printf("n=%-9zu build  std::map %8.4f s   FlatMap %8.4f s   x%.2f\n",
+                n, treeBuild, flatBuild, treeBuild / flatBuild);
+    std::printf("n=%-9zu find   std::map %8.2f Mops/s   FlatMap %8.2f Mops/s   x%.2f\n",
+                n, m / treeFind, m / flatFind, treeFind / flatFind);
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t n : {1000u, 100000u, 1000000u}) {
+        compare(n);
+    }
+    return 0;
+}
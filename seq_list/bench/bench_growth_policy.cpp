@@ -0,0 +1,65 @@
+// bench_growth_policy.cpp
+// Longest single pushBack (the largest reallocation) and total time to grow
+// a SeqList<std::uint64_t> to a large size under each growth policy.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "seq_list.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A policy that always moves into a fresh buffer, as the containers did
+// before growth policies: every reallocation copies every byte
+struct CopyingGrowth : ds::GeometricGrowth<> {
+    template <class T>
+    static T* reallocate(T* data, std::size_t capacity, std::size_t newCapacity) {
+        T* fresh = allocate<T>(newCapacity);
+        std::memcpy(static_cast<void*>(fresh), data, capacity * sizeof(T));
+        deallocate(data, capacity);
+        return fresh;
+    }
+};
+
+template <class Growth>
+void run(const char* name, std::size_t n) {
+    ds::SeqList<std::uint64_t, 0, Growth> list;
+    double worst = 0.0;
+    auto begin = Clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (list.size() == list.capacity()) {
+            auto start = Clock::now();
+            list.pushBack(i);
+            double pause = std::chrono::duration<double>(Clock::now() - start).count();
+            if (pause > worst) {
+                worst = pause;
+            }
+        } else {
+            list.pushBack(i);
+        }
+    }
+    double total = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    std::printf("%-22s %6zu MiB   worst pushBack %9.3f ms   total %8.3f s\n",
+                name, n * sizeof(std::uint64_t) >> 20, worst * 1e3, total);
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t mib : {64u, 512u}) {
+        std::size_t n = (mib << 20) / sizeof(std::uint64_t);
+        run<CopyingGrowth>("copy on growth", n);
+        run<ds::GeometricGrowth<>>("GeometricGrowth", n);
+        run<ds::PageRoundedGrowth<>>("PageRoundedGrowth", n);
+        run<ds::MappedGrowth<ds::GeometricGrowth<>, false>>("MappedGrowth", n);
+        run<ds::MappedGrowth<>>("MappedGrowth+huge", n);
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+// bench_seq_list.cpp
+// pushBack throughput of SeqList<T> against the previous growth strategy
+// (new T[] storage, copy-assigning every element on each reallocation).
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "seq_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+// The SeqList growth path as it was before raw storage: every slot is
+// default-constructed up front and growth copy-assigns into a new array.
+template <typename T>
+class LegacySeqList {
+public:
+    LegacySeqList() : size_(0), capacity_(4), data_(new T[4]) {}
+    ~LegacySeqList() { delete[] data_; }
+
+    LegacySeqList(const LegacySeqList&) = delete;
+    LegacySeqList& operator=(const LegacySeqList&) = delete;
+
+    template <class U>
+    void pushBack(U&& value) {
+        if (size_ >= capacity_) {
+            std::size_t newCapacity = capacity_ * 2;
+            T* newData = new T[newCapacity];
+            for (std::size_t i = 0; i < size_; ++i) {
+                newData[i] = data_[i];
+            }
+            delete[] data_;
+            data_ = newData;
+            capacity_ = newCapacity;
+        }
+        data_[size_++] = std::forward<U>(value);
+    }
+
+    std::size_t size() const { return size_; }
+
+private:
+    std::size_t size_;
+    std::size_t capacity_;
+    T* data_;
+};
+
+struct Record {
+    long id;
+    double score;
+    std::string name;
+};
+
+template <typename List, typename Make>
+double run(std::size_t n, int rounds, Make make) {
+    using Clock = std::chrono::steady_clock;
+    double best = 0.0;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = Clock::now();
+        List list;
+        for (std::size_t i = 0; i < n; ++i) {
+            list.pushBack(make(i));
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        double mops = static_cast<double>(list.size()) / elapsed.count() / 1e6;
+        if (mops > best) {
+            best = mops;
+        }
+    }
+    return best;
+}
+
+template <typename T, typename Make>
+void compare(const char* name, std::size_t n, int rounds, Make make) {
+    double before = run<LegacySeqList<T>>(n, rounds, make);
+    double after = run<ds::SeqList<T>>(n, rounds, make);
+    std::printf("%-12s n=%-9zu legacy %9.2f Mops/s   SeqList %9.2f Mops/s   x%.2f\n",
+                name, n, before, after, after / before);
+}
+
+} // namespace
+
+int main() {
+    constexpr int kRounds = 5;
+
+    for (std::size_t n : {1000u, 100000u, 2000000u}) {
+        compare<int>("int", n, kRounds, [](std::size_t i) { return static_cast<int>(i); });
+        compare<std::string>("std::string", n, kRounds, [](std::size_t i) {
+            return std::string(24, 'x') + std::to_string(i);  // defeats SSO
+        });
+        compare<Record>("Record", n, kRounds, [](std::size_t i) {
+            return Record{static_cast<long>(i), 0.5 * i, std::string(24, 'r')};
+        });
+    }
+    return 0;
+}
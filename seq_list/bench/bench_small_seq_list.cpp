@@ -0,0 +1,107 @@
+// bench_small_seq_list.cpp
+// Allocation count and latency of short-lived lists: SeqList<T> against
+// SmallSeqList<T, N> for lists that stay within, or just outgrow, N.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include <cstdlib>
+
+#include "seq_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Counts heap allocations by interposing malloc/realloc; glibc only.
+#if defined(__GLIBC__)
+#define BENCH_COUNT_ALLOCATIONS 1
+
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_realloc(void* ptr, std::size_t size);
+
+namespace {
+std::size_t g_allocations = 0;
+}
+
+extern "C" void* malloc(std::size_t size) {
+    ++g_allocations;
+    return __libc_malloc(size);
+}
+
+extern "C" void* realloc(void* ptr, std::size_t size) {
+    ++g_allocations;
+    return __libc_realloc(ptr, size);
+}
+#else
+#define BENCH_COUNT_ALLOCATIONS 0
+#endif
+
+namespace {
+
+std::size_t allocations() {
+#if BENCH_COUNT_ALLOCATIONS
+    return g_allocations;
+#else
+    return 0;
+#endif
+}
+
+struct Result {
+    double nsPerList;
+    double allocationsPerList;
+};
+
+// Builds and destroys `lists` lists of `length` elements each
+template <typename List, typename Make>
+Result run(std::size_t lists, std::size_t length, Make make) {
+    using Clock = std::chrono::steady_clock;
+    std::size_t checksum = 0;
+    std::size_t before = allocations();
+    auto start = Clock::now();
+
+    for (std::size_t i = 0; i < lists; ++i) {
+        List list;
+        for (std::size_t j = 0; j < length; ++j) {
+            list.pushBack(make(j));
+        }
+        checksum += list.size();
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    std::size_t after = allocations();
+    if (checksum != lists * length) {
+        std::printf("unexpected checksum\n");
+    }
+    return {elapsed.count() / static_cast<double>(lists),
+            static_cast<double>(after - before) / static_cast<double>(lists)};
+}
+
+template <typename T, std::size_t N, typename Make>
+void compare(const char* name, std::size_t lists, std::size_t length, Make make) {
+    Result heap = run<ds::SeqList<T>>(lists, length, make);
+    Result small = run<ds::SmallSeqList<T, N>>(lists, length, make);
+    std::printf("%-12s N=%-2zu len=%-2zu  SeqList %8.1f ns %5.2f allocs   "
+                "SmallSeqList %8.1f ns %5.2f allocs\n",
+                name, N, length, heap.nsPerList, heap.allocationsPerList,
+                small.nsPerList, small.allocationsPerList);
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kLists = 2000000;
+
+#if !BENCH_COUNT_ALLOCATIONS
+    std::printf("(allocation counting needs glibc; counts below read 0)\n");
+#endif
+
+    for (std::size_t length : {0u, 2u, 4u, 8u, 9u}) {
+        compare<int, 8>("int", kLists, length, [](std::size_t j) { return static_cast<int>(j); });
+    }
+    for (std::size_t length : {0u, 2u, 4u, 5u}) {
+        compare<std::string, 4>("std::string", kLists / 4, length, [](std::size_t j) {
+            return std::string(1, static_cast<char>('a' + j));  // fits SSO
+        });
+    }
+    return 0;
+}
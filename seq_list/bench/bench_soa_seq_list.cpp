@@ -0,0 +1,115 @@
+// bench_soa_seq_list.cpp
+// Scans over one and two fields of a 12-field record, stored as a
+// SeqList<Record> and as a SoASeqList of the same fields.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "seq_list.hpp"
+#include "soa_seq_list.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Record {
+    std::int64_t id;
+    std::int64_t timestamp;
+    double price;
+    double quantity;
+    double fee;
+    double tax;
+    std::int32_t region;
+    std::int32_t product;
+    std::int32_t customer;
+    std::int32_t channel;
+    float discount;
+    float rating;
+};
+
+using Columns = ds::SoASeqList<std::int64_t, std::int64_t, double, double, double, double,
+                               std::int32_t, std::int32_t, std::int32_t, std::int32_t,
+                               float, float>;
+
+template <typename F>
+double bestOf(int rounds, F&& scan) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = Clock::now();
+        scan();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+volatile double sink;
+
+} // namespace
+
+int main() {
+    constexpr int kRounds = 5;
+
+    for (std::size_t n : {10000u, 1000000u, 10000000u}) {
+        ds::SeqList<Record> rows;
+        Columns columns;
+        rows.reserve(n);
+        columns.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            Record r{static_cast<std::int64_t>(i), static_cast<std::int64_t>(i * 10),
+                     1.0 + i % 7, 2.0 + i % 5, 0.1, 0.2,
+                     static_cast<std::int32_t>(i % 16), static_cast<std::int32_t>(i % 1000),
+                     static_cast<std::int32_t>(i % 50000), static_cast<std::int32_t>(i % 4),
+                     0.05f, 4.5f};
+            rows.pushBack(r);
+            columns.pushBack(r.id, r.timestamp, r.price, r.quantity, r.fee, r.tax, r.region,
+                             r.product, r.customer, r.channel, r.discount, r.rating);
+        }
+
+        // One field: total price
+        double aos1 = bestOf(kRounds, [&] {
+            double total = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                total += rows[i].price;
+            }
+            sink = total;
+        });
+        double soa1 = bestOf(kRounds, [&] {
+            const double* price = columns.column<2>();
+            double total = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                total += price[i];
+            }
+            sink = total;
+        });
+
+        // Two fields: revenue
+        double aos2 = bestOf(kRounds, [&] {
+            double total = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                total += rows[i].price * rows[i].quantity;
+            }
+            sink = total;
+        });
+        double soa2 = bestOf(kRounds, [&] {
+            const double* price = columns.column<2>();
+            const double* quantity = columns.column<3>();
+            double total = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                total += price[i] * quantity[i];
+            }
+            sink = total;
+        });
+
+        std::printf("n=%-9zu 1 field   SeqList<Record> %8.4f s   SoASeqList %8.4f s   x%.2f\n",
+                    n, aos1, soa1, aos1 / soa1);
+        std::printf("n=%-9zu 2 fields  SeqList<Record> %8.4f s   SoASeqList %8.4f s   x%.2f\n",
+                    n, aos2, soa2, aos2 / soa2);
+    }
+    return 0;
+}
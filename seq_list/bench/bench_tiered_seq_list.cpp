@@ -0,0 +1,100 @@
+// bench_tiered_seq_list.cpp
+// Front, middle and back insertion, middle erasure and random reads of
+// TieredSeqList<T> against SeqList<T>.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "seq_list.hpp"
+#include "tiered_seq_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::size_t weight(int value) { return static_cast<std::size_t>(value); }
+std::size_t weight(const std::string& value) { return value.size(); }
+
+// Time, in seconds, of each workload on one list type
+template <template <typename> class List, typename T, typename Make>
+void measure(std::size_t n, Make make, double (&times)[5]) {
+    List<T> list;
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        list.pushFront(make(i));
+    }
+    times[0] = seconds(start);
+
+    list.clear();
+    start = Clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        list.insert(list.size() / 2, make(i));
+    }
+    times[1] = seconds(start);
+
+    list.clear();
+    start = Clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        list.pushBack(make(i));
+    }
+    times[2] = seconds(start);
+
+    // Reads through a pseudo-random permutation, so nothing is sequential
+    start = Clock::now();
+    std::size_t checksum = 0;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        pos = (pos + 7919) % n;
+        checksum += weight(list[pos]);
+    }
+    times[3] = seconds(start);
+
+    start = Clock::now();
+    while (!list.empty()) {
+        list.erase(list.size() / 2);
+    }
+    times[4] = seconds(start);
+
+    if (checksum == 0) {
+        std::printf("unreachable\n");
+    }
+}
+
+// SeqList has a second template parameter; this fixes it to the default
+template <typename T>
+using Plain = ds::SeqList<T>;
+
+template <typename T, typename Make>
+void compare(const char* name, std::size_t n, Make make) {
+    static const char* const kWorkloads[] = {"pushFront", "insert mid", "pushBack",
+                                             "random read", "erase mid"};
+    double plain[5];
+    double tiered[5];
+    measure<Plain, T>(n, make, plain);
+    measure<ds::TieredSeqList, T>(n, make, tiered);
+
+    for (int w = 0; w < 5; ++w) {
+        std::printf("%-12s n=%-8zu %-12s SeqList %9.4f s   TieredSeqList %9.4f s   x%.2f\n",
+                    name, n, kWorkloads[w], plain[w], tiered[w], plain[w] / tiered[w]);
+    }
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t n : {1000u, 10000u, 100000u}) {
+        compare<int>("int", n, [](std::size_t i) { return static_cast<int>(i); });
+        compare<std::string>("std::string", n, [](std::size_t i) {
+            return std::string(24, 'x') + std::to_string(i);  // defeats SSO
+        });
+    }
+    return 0;
+}
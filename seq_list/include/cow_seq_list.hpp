@@ -0,0 +1,325 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+#include "seq_list.hpp"
+
+namespace ds {
+
+// CowSeqList: a sequential list whose copies and snapshots share one
+// buffer until somebody writes to it (copy-on-write).
+//
+// snapshot() and copying are O(1): they take a reference to the buffer.
+// A write first checks whether the buffer is shared and, only if it is,
+// copies it; a list that holds the only reference writes in place, as a
+// SeqList would. Reference counts are atomic and never taken under a lock,
+// so readers never block and never copy.
+//
+// A CowSeqList object belongs to one writer at a time, like any SeqList.
+// The Snapshots it hands out are immutable and can be read, copied and
+// dropped from any number of threads.
+template <typename T>
+class CowSeqList {
+private:
+    struct Buffer;
+
+public:
+    using size_type = std::size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    class Snapshot;
+
+    CowSeqList();
+    ~CowSeqList();
+
+    CowSeqList(const CowSeqList& other) noexcept;
+    CowSeqList& operator=(CowSeqList other) noexcept;
+    CowSeqList(CowSeqList&& other) noexcept;
+
+    // A writable list that starts out sharing the snapshot's buffer
+    explicit CowSeqList(const Snapshot& snapshot) noexcept;
+
+    // An immutable view of the current contents, in O(1)
+    Snapshot snapshot() const noexcept;
+
+    template<class U>
+    void pushBack(U&& value);
+
+    template<class U>
+    void pushFront(U&& value);
+
+    void popBack();
+    void popFront();
+
+    template<class U>
+    bool insert(size_type pos, U&& value);
+
+    bool erase(size_type pos);
+
+    void set(size_type pos, const T& value);
+
+    void reserve(size_type newCapacity);
+    void clear();
+
+    size_type find(const T& value) const noexcept;
+    size_type count(const T& value) const noexcept;
+
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    // Element access is read-only: a mutable reference would have to copy a
+    // shared buffer even when it is only read. Write through set().
+    const T& operator[](size_type pos) const;
+    const T* data() const noexcept;
+
+    // True while another list or snapshot holds the same buffer
+    bool shared() const noexcept;
+
+private:
+    struct Buffer {
+        Buffer() = default;
+        explicit Buffer(const SeqList<T>& source) : items(source) {}
+
+        std::atomic<size_type> refs{1};
+        SeqList<T> items;
+    };
+
+    static Buffer* retain(Buffer* buffer) noexcept;
+    static void release(Buffer* buffer) noexcept;
+
+    // Gives this list a buffer of its own. Returns the reference it dropped,
+    // if any, so that the caller's arguments, which may point into the old
+    // buffer, outlive the write.
+    Snapshot detach();
+
+    void swap(CowSeqList& other) noexcept;
+
+private:
+    Buffer* buffer_ = nullptr;      // nullptr only when moved from: empty
+};
+
+// Snapshot: an immutable, shared view of a CowSeqList's contents
+template <typename T>
+class CowSeqList<T>::Snapshot {
+public:
+    Snapshot() noexcept = default;
+    ~Snapshot() { release(buffer_); }
+
+    Snapshot(const Snapshot& other) noexcept : buffer_(retain(other.buffer_)) {}
+    Snapshot(Snapshot&& other) noexcept : buffer_(std::exchange(other.buffer_, nullptr)) {}
+
+    Snapshot& operator=(Snapshot other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        return *this;
+    }
+
+    size_type size() const noexcept { return buffer_ ? buffer_->items.size() : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    const T& operator[](size_type pos) const {
+        assert(pos < size());
+        return buffer_->items[pos];
+    }
+
+    const T* data() const noexcept { return buffer_ ? buffer_->items.data() : nullptr; }
+
+    size_type find(const T& value) const noexcept {
+        return buffer_ ? buffer_->items.find(value) : npos;
+    }
+
+    size_type count(const T& value) const noexcept {
+        return buffer_ ? buffer_->items.count(value) : 0;
+    }
+
+private:
+    friend class CowSeqList;
+
+    // Adopts a reference that the caller already holds
+    explicit Snapshot(Buffer* buffer) noexcept : buffer_(buffer) {}
+
+    Buffer* buffer_ = nullptr;
+};
+
+template <typename T>
+CowSeqList<T>::CowSeqList()
+    : buffer_(new Buffer()) {}
+
+template <typename T>
+CowSeqList<T>::~CowSeqList() {
+    release(buffer_);
+    buffer_ = nullptr;
+}
+
+template <typename T>
+CowSeqList<T>::CowSeqList(const CowSeqList& other) noexcept
+    : buffer_(retain(other.buffer_)) {}
+
+template <typename T>
+CowSeqList<T>& CowSeqList<T>::operator=(CowSeqList other) noexcept {
+    swap(other);
+    return *this;
+}
+
+template <typename T>
+CowSeqList<T>::CowSeqList(CowSeqList&& other) noexcept
+    : buffer_(std::exchange(other.buffer_, nullptr)) {}
+
+template <typename T>
+CowSeqList<T>::CowSeqList(const Snapshot& snapshot) noexcept
+    : buffer_(retain(snapshot.buffer_)) {}
+
+template <typename T>
+typename CowSeqList<T>::Snapshot CowSeqList<T>::snapshot() const noexcept {
+    return Snapshot(retain(buffer_));
+}
+
+template <typename T>
+template <class U>
+void CowSeqList<T>::pushBack(U&& value) {
+    Snapshot previous = detach();
+    buffer_->items.pushBack(std::forward<U>(value));
+}
+
+template <typename T>
+template <class U>
+void CowSeqList<T>::pushFront(U&& value) {
+    Snapshot previous = detach();
+    buffer_->items.pushFront(std::forward<U>(value));
+}
+
+template <typename T>
+void CowSeqList<T>::popBack() {
+    assert(size() > 0 && "Cannot pop from an empty list.");
+    Snapshot previous = detach();
+    buffer_->items.popBack();
+}
+
+template <typename T>
+void CowSeqList<T>::popFront() {
+    assert(size() > 0 && "Cannot pop from an empty list.");
+    Snapshot previous = detach();
+    buffer_->items.popFront();
+}
+
+template <typename T>
+template <class U>
+bool CowSeqList<T>::insert(size_type pos, U&& value) {
+    if (pos > size()) {
+        return false;
+    }
+    Snapshot previous = detach();
+    return buffer_->items.insert(pos, std::forward<U>(value));
+}
+
+template <typename T>
+bool CowSeqList<T>::erase(size_type pos) {
+    if (pos >= size()) {
+        return false;
+    }
+    Snapshot previous = detach();
+    return buffer_->items.erase(pos);
+}
+
+template <typename T>
+void CowSeqList<T>::set(size_type pos, const T& value) {
+    assert(pos < size());
+    Snapshot previous = detach();
+    buffer_->items.set(pos, value);
+}
+
+template <typename T>
+void CowSeqList<T>::reserve(size_type newCapacity) {
+    Snapshot previous = detach();
+    buffer_->items.reserve(newCapacity);
+}
+
+// Clearing a shared list needs no copy: it just starts a new buffer
+template <typename T>
+void CowSeqList<T>::clear() {
+    if (shared() || buffer_ == nullptr) {
+        Buffer* fresh = new Buffer();
+        release(buffer_);
+        buffer_ = fresh;
+        return;
+    }
+    buffer_->items.clear();
+}
+
+template <typename T>
+typename CowSeqList<T>::size_type CowSeqList<T>::find(const T& value) const noexcept {
+    return buffer_ ? buffer_->items.find(value) : npos;
+}
+
+template <typename T>
+typename CowSeqList<T>::size_type CowSeqList<T>::count(const T& value) const noexcept {
+    return buffer_ ? buffer_->items.count(value) : 0;
+}
+
+template <typename T>
+typename CowSeqList<T>::size_type CowSeqList<T>::size() const noexcept {
+    return buffer_ ? buffer_->items.size() : 0;
+}
+
+template <typename T>
+bool CowSeqList<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template <typename T>
+const T& CowSeqList<T>::operator[](size_type pos) const {
+    assert(pos < size());
+    return buffer_->items[pos];
+}
+
+template <typename T>
+const T* CowSeqList<T>::data() const noexcept {
+    return buffer_ ? buffer_->items.data() : nullptr;
+}
+
+// The count can only drop below what we read while we look: every other
+// reference is held by someone else, and new ones are only made from ours
+template <typename T>
+bool CowSeqList<T>::shared() const noexcept {
+    return buffer_ != nullptr && buffer_->refs.load(std::memory_order_acquire) > 1;
+}
+
+// Taking a reference needs no ordering: the caller already holds one
+template <typename T>
+typename CowSeqList<T>::Buffer* CowSeqList<T>::retain(Buffer* buffer) noexcept {
+    if (buffer != nullptr) {
+        buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return buffer;
+}
+
+// The last owner must see every other owner's reads finished before it
+// destroys the buffer, hence acq_rel
+template <typename T>
+void CowSeqList<T>::release(Buffer* buffer) noexcept {
+    if (buffer != nullptr && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete buffer;
+    }
+}
+
+template <typename T>
+typename CowSeqList<T>::Snapshot CowSeqList<T>::detach() {
+    if (buffer_ == nullptr) {
+        buffer_ = new Buffer();
+        return Snapshot();
+    }
+    if (!shared()) {
+        return Snapshot();
+    }
+    Buffer* copy = new Buffer(buffer_->items);
+    return Snapshot(std::exchange(buffer_, copy));
+}
+
+template <typename T>
+void CowSeqList<T>::swap(CowSeqList& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+}
+
+}
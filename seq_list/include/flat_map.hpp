@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "seq_list.hpp"
+
+namespace ds {
+
+// FlatMap: a sorted map over two contiguous SeqLists, one of keys and one of
+// values, with the lookup API of AVLTree (find/contains/insert/erase).
+//
+// Lookups binary-search the key array alone, which stays dense in cache.
+// Single inserts and erases shift the arrays and are O(n); load many pairs
+// through the bulk constructor or insertBatch, which sort once and merge.
+// Keys are ordered with operator<, as in AVLTree.
+template <typename K, typename V>
+class FlatMap {
+public:
+    using size_type = std::size_t;
+
+    FlatMap() = default;
+
+    // Bulk build from pairs in any order; of repeated keys the last one wins
+    template <class InputIt, typename = detail::RequireInputIterator<InputIt>>
+    FlatMap(InputIt first, InputIt last);
+    FlatMap(std::initializer_list<std::pair<K, V>> init);
+
+    // Insert or update
+    template <typename Key, typename Value>
+    void insert(Key&& key, Value&& value);
+
+    // Inserts or updates every pair in [first, last) with one sort of the
+    // batch and one merge pass: O(n + m log(n + m)) for m pairs. Of repeated
+    // keys in the batch the last one wins.
+    template <class InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void insertBatch(InputIt first, InputIt last);
+
+    bool erase(const K& key);
+
+    bool contains(const K& key) const;
+
+    V* find(const K& key);
+    const V* find(const K& key) const;
+
+    // Entries in key order
+    const K& keyAt(size_type pos) const;
+    V& valueAt(size_type pos);
+    const V& valueAt(size_type pos) const;
+
+    size_type size() const;
+    bool empty() const;
+    void clear();
+    void reserve(size_type newCapacity);
+
+private:
+    using Entries = SeqList<std::pair<K, V>>;
+
+    // Index of the first key not less than key
+    size_type lowerBound(const K& key) const noexcept;
+    size_type indexOf(const K& key) const noexcept;
+
+    // Sorts entries by key and drops all but the last of each repeated key
+    static void sortUnique(Entries& entries);
+
+    void assignSorted(Entries& entries);
+
+private:
+    SeqList<K> keys_;
+    SeqList<V> values_;
+};
+
+template <typename K, typename V>
+template <class InputIt, typename>
+FlatMap<K, V>::FlatMap(InputIt first, InputIt last) {
+    Entries entries;
+    for (; first != last; ++first) {
+        entries.pushBack(*first);
+    }
+    sortUnique(entries);
+    assignSorted(entries);
+}
+
+template <typename K, typename V>
+FlatMap<K, V>::FlatMap(std::initializer_list<std::pair<K, V>> init)
+    : FlatMap(init.begin(), init.end()) {}
+
+template <typename K, typename V>
+template <typename Key, typename Value>
+void FlatMap<K, V>::insert(Key&& key, Value&& value) {
+    size_type pos = lowerBound(key);
+    if (pos < keys_.size() && !(key < keys_[pos])) {
+        values_[pos] = std::forward<Value>(value);
+        return;
+    }
+
+    keys_.insert(pos, std::forward<Key>(key));
+    try {
+        values_.insert(pos, std::forward<Value>(value));
+    } catch (...) {
+        keys_.erase(pos);
+        throw;
+    }
+}
+
+// Existing entries move once, into arrays sized for the merged result
+template <typename K, typename V>
+template <class InputIt, typename>
+void FlatMap<K, V>::insertBatch(InputIt first, InputIt last) {
+    Entries batch;
+    for (; first != last; ++first) {
+        batch.pushBack(*first);
+    }
+    if (batch.empty()) {
+        return;
+    }
+    sortUnique(batch);
+
+    // Updates of existing keys happen in place; only new keys are merged
+    size_type fresh = 0;
+    for (size_type i = 0; i < batch.size(); ++i) {
+        size_type pos = indexOf(batch[i].first);
+        if (pos == keys_.size()) {
+            if (fresh != i) {
+                batch[fresh] = std::move(batch[i]);
+            }
+            ++fresh;
+        } else {
+            values_[pos] = std::move(batch[i].second);
+        }
+    }
+    batch.eraseRange(fresh, batch.size() - fresh);
+    if (fresh == 0) {
+        return;
+    }
+
+    SeqList<K> keys;
+    SeqList<V> values;
+    keys.reserve(keys_.size() + fresh);
+    values.reserve(keys_.size() + fresh);
+
+    size_type i = 0;
+    size_type j = 0;
+    while (i < keys_.size() || j < fresh) {
+        if (j == fresh || (i < keys_.size() && keys_[i] < batch[j].first)) {
+            keys.pushBack(std::move(keys_[i]));
+            values.pushBack(std::move(values_[i]));
+            ++i;
+        } else {
+            keys.pushBack(std::move(batch[j].first));
+            values.pushBack(std::move(batch[j].second));
+            ++j;
+        }
+    }
+
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+}
+
+template <typename K, typename V>
+bool FlatMap<K, V>::erase(const K& key) {
+    size_type pos = indexOf(key);
+    if (pos == keys_.size()) {
+        return false;
+    }
+    keys_.erase(pos);
+    values_.erase(pos);
+    return true;
+}
+
+template <typename K, typename V>
+bool FlatMap<K, V>::contains(const K& key) const {
+    return indexOf(key) != keys_.size();
+}
+
+template <typename K, typename V>
+V* FlatMap<K, V>::find(const K& key) {
+    size_type pos = indexOf(key);
+    return pos == keys_.size() ? nullptr : &values_[pos];
+}
+
+template <typename K, typename V>
+const V* FlatMap<K, V>::find(const K& key) const {
+    size_type pos = indexOf(key);
+    return pos == keys_.size() ? nullptr : &values_[pos];
+}
+
+template <typename K, typename V>
+const K& FlatMap<K, V>::keyAt(size_type pos) const {
+    assert(pos < keys_.size());
+    return keys_[pos];
+}
+
+template <typename K, typename V>
+V& FlatMap<K, V>::valueAt(size_type pos) {
+    assert(pos < values_.size());
+    return values_[pos];
+}
+
+template <typename K, typename V>
+const V& FlatMap<K, V>::valueAt(size_type pos) const {
+    assert(pos < values_.size());
+    return values_[pos];
+}
+
+template <typename K, typename V>
+typename FlatMap<K, V>::size_type FlatMap<K, V>::size() const {
+    return keys_.size();
+}
+
+template <typename K, typename V>
+bool FlatMap<K, V>::empty() const {
+    return keys_.empty();
+}
+
+template <typename K, typename V>
+void FlatMap<K, V>::clear() {
+    keys_.clear();
+    values_.clear();
+}
+
+template <typename K, typename V>
+void FlatMap<K, V>::reserve(size_type newCapacity) {
+    keys_.reserve(newCapacity);
+    values_.reserve(newCapacity);
+}
+
+// Branchless binary search: each step halves the range with a conditional
+// move instead of a branch, so there is nothing to mispredict and the loop
+// runs exactly ceil(log2 n) times. The compiler turns the ternary into a
+// cmov for arithmetic keys.
+template <typename K, typename V>
+typename FlatMap<K, V>::size_type FlatMap<K, V>::lowerBound(const K& key) const noexcept {
+    size_type n = keys_.size();
+    if (n == 0) {
+        return 0;
+    }
+
+    const K* base = keys_.data();
+    while (n > 1) {
+        size_type half = n / 2;
+        base = (base[half] < key) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<size_type>(base - keys_.data()) + (*base < key ? 1 : 0);
+}
+
+// Position of key, or size() if it is absent
+template <typename K, typename V>
+typename FlatMap<K, V>::size_type FlatMap<K, V>::indexOf(const K& key) const noexcept {
+    size_type pos = lowerBound(key);
+    if (pos < keys_.size() && !(key < keys_[pos])) {
+        return pos;
+    }
+    return keys_.size();
+}
+
+// A stable sort keeps repeated keys in input order, so the last of each run
+// is the most recent
+template <typename K, typename V>
+void FlatMap<K, V>::sortUnique(Entries& entries) {
+    std::pair<K, V>* data = entries.data();
+    std::stable_sort(data, data + entries.size(),
+                     [](const std::pair<K, V>& a, const std::pair<K, V>& b) {
+                         return a.first < b.first;
+                     });
+
+    size_type kept = 0;
+    for (size_type i = 0; i < entries.size(); ++i) {
+        if (kept > 0 && !(data[kept - 1].first < data[i].first)) {
+            data[kept - 1] = std::move(data[i]);
+        } else {
+            if (kept != i) {
+                data[kept] = std::move(data[i]);
+            }
+            ++kept;
+        }
+    }
+    entries.eraseRange(kept, entries.size() - kept);
+}
+
+template <typename K, typename V>
+void FlatMap<K, V>::assignSorted(Entries& entries) {
+    keys_.clear();
+    values_.clear();
+    reserve(entries.size());
+    for (size_type i = 0; i < entries.size(); ++i) {
+        keys_.pushBack(std::move(entries[i].first));
+        values_.pushBack(std::move(entries[i].second));
+    }
+}
+
+}
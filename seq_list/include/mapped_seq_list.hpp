@@ -0,0 +1,374 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simd_scan.hpp"
+
+namespace ds {
+
+// MappedSeqList: a sequential list of trivially copyable elements whose
+// storage is a memory-mapped file (POSIX).
+//
+// Opening maps the file as it is, so an existing list is available in O(1)
+// and read without copying. The element count lives in the mapped header and
+// is therefore persistent too. Writes reach the file through the page cache;
+// call flush() to wait until they are on disk.
+template <typename T>
+class MappedSeqList {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "MappedSeqList stores elements as raw bytes");
+    static_assert(alignof(T) <= 64, "MappedSeqList aligns elements to 64 bytes");
+
+public:
+    using size_type = std::size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Opens the list stored at path, creating an empty one if the file does
+    // not exist or is empty. Throws std::system_error on I/O failure and
+    // std::runtime_error if the file holds something else.
+    explicit MappedSeqList(const std::string& path);
+    ~MappedSeqList();
+
+    MappedSeqList(const MappedSeqList&) = delete;
+    MappedSeqList(MappedSeqList&& other) noexcept;
+    MappedSeqList& operator=(MappedSeqList other) noexcept;
+
+    void pushBack(const T& value);
+    void popBack();
+
+    bool insert(size_type pos, const T& value);
+    bool erase(size_type pos);
+
+    size_type find(const T& value) const noexcept;
+    size_type count(const T& value) const noexcept;
+
+    void set(size_type pos, const T& value);
+
+    void reserve(size_type newCapacity);
+    void clear() noexcept;
+
+    // Blocks until every change so far has been written to the file
+    void flush();
+
+    size_type size() const;
+    size_type capacity() const;
+    bool empty() const;
+
+    T* data() noexcept;
+    const T* data() const noexcept;
+
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+private:
+    // On-disk layout: this header, padded to kHeaderSize, then the elements
+    struct Header {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t elementSize;
+        std::uint64_t size;
+        std::uint64_t capacity;
+    };
+
+    void map(size_type bytes);
+    void remap(size_type newCapacity);
+    void ensureCapacity();
+    void swap(MappedSeqList& other) noexcept;
+
+    Header* header() const noexcept;
+    T* elements() const noexcept;
+
+    static size_type bytesFor(size_type capacity) noexcept;
+    [[noreturn]] static void throwErrno(const char* what);
+
+private:
+    int fd_ = -1;
+    void* base_ = nullptr;          // start of the mapping (the header)
+    size_type mappedBytes_ = 0;
+
+    static constexpr std::uint64_t kMagic = 0x5453494C51455344ull;   // "DSEQLIST"
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr size_type kHeaderSize = 64;
+    static constexpr size_type kInitialCapacity = 1024;
+};
+
+template <typename T>
+MappedSeqList<T>::MappedSeqList(const std::string& path) {
+    static_assert(sizeof(Header) <= kHeaderSize);
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throwErrno("MappedSeqList: open");
+    }
+
+    try {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            throwErrno("MappedSeqList: fstat");
+        }
+
+        if (st.st_size == 0) {
+            // New list: size the file and write a fresh header
+            size_type bytes = bytesFor(kInitialCapacity);
+            if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+                throwErrno("MappedSeqList: ftruncate");
+            }
+            map(bytes);
+            *header() = Header{kMagic, kVersion, sizeof(T), 0, kInitialCapacity};
+            return;
+        }
+
+        if (static_cast<size_type>(st.st_size) < kHeaderSize) {
+            throw std::runtime_error("MappedSeqList: file too small: " + path);
+        }
+        map(static_cast<size_type>(st.st_size));
+
+        const Header& h = *header();
+        if (h.magic != kMagic || h.version != kVersion) {
+            throw std::runtime_error("MappedSeqList: not a list file: " + path);
+        }
+        if (h.elementSize != sizeof(T)) {
+            throw std::runtime_error("MappedSeqList: element size mismatch: " + path);
+        }
+        if (h.size > h.capacity || bytesFor(h.capacity) > mappedBytes_) {
+            throw std::runtime_error("MappedSeqList: corrupt header: " + path);
+        }
+    } catch (...) {
+        if (base_ != nullptr) {
+            ::munmap(base_, mappedBytes_);
+        }
+        ::close(fd_);
+        throw;
+    }
+}
+
+// Unmapping does not lose data: the kernel writes dirty pages back on its
+// own schedule. Only flush() waits for them.
+template <typename T>
+MappedSeqList<T>::~MappedSeqList() {
+    if (base_ != nullptr) {
+        ::munmap(base_, mappedBytes_);
+        base_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    mappedBytes_ = 0;
+}
+
+template <typename T>
+MappedSeqList<T>::MappedSeqList(MappedSeqList&& other) noexcept
+    : fd_(other.fd_), base_(other.base_), mappedBytes_(other.mappedBytes_) {
+    other.fd_ = -1;
+    other.base_ = nullptr;
+    other.mappedBytes_ = 0;
+}
+
+template <typename T>
+MappedSeqList<T>& MappedSeqList<T>::operator=(MappedSeqList other) noexcept {
+    swap(other);
+    return *this;
+}
+
+template <typename T>
+void MappedSeqList<T>::pushBack(const T& value) {
+    T copy = value;   // value may live in the mapping that ensureCapacity moves
+    ensureCapacity();
+    elements()[header()->size++] = copy;
+}
+
+template <typename T>
+void MappedSeqList<T>::popBack() {
+    assert(size() > 0 && "Cannot pop from an empty list.");
+    --header()->size;
+}
+
+template <typename T>
+bool MappedSeqList<T>::insert(size_type pos, const T& value) {
+    if (pos > size()) {
+        return false;
+    }
+    T copy = value;
+    ensureCapacity();
+    T* data = elements();
+    std::memmove(static_cast<void*>(data + pos + 1), data + pos, (size() - pos) * sizeof(T));
+    data[pos] = copy;
+    ++header()->size;
+    return true;
+}
+
+template <typename T>
+bool MappedSeqList<T>::erase(size_type pos) {
+    if (pos >= size()) {
+        return false;
+    }
+    T* data = elements();
+    std::memmove(static_cast<void*>(data + pos), data + pos + 1, (size() - pos - 1) * sizeof(T));
+    --header()->size;
+    return true;
+}
+
+template <typename T>
+typename MappedSeqList<T>::size_type MappedSeqList<T>::find(const T& value) const noexcept {
+    detail::simd::FirstMatch sink;
+    detail::simd::scan(data(), size(), detail::simd::EqualTo<T>{value}, sink);
+    return sink.pos;
+}
+
+template <typename T>
+typename MappedSeqList<T>::size_type MappedSeqList<T>::count(const T& value) const noexcept {
+    detail::simd::CountMatches sink;
+    detail::simd::scan(data(), size(), detail::simd::EqualTo<T>{value}, sink);
+    return sink.count;
+}
+
+template <typename T>
+void MappedSeqList<T>::set(size_type pos, const T& value) {
+    assert(pos < size());
+    elements()[pos] = value;
+}
+
+template <typename T>
+void MappedSeqList<T>::reserve(size_type newCapacity) {
+    if (newCapacity > capacity()) {
+        remap(newCapacity);
+    }
+}
+
+template <typename T>
+void MappedSeqList<T>::clear() noexcept {
+    header()->size = 0;
+}
+
+template <typename T>
+void MappedSeqList<T>::flush() {
+    if (::msync(base_, mappedBytes_, MS_SYNC) != 0) {
+        throwErrno("MappedSeqList: msync");
+    }
+}
+
+template <typename T>
+typename MappedSeqList<T>::size_type MappedSeqList<T>::size() const {
+    return static_cast<size_type>(header()->size);
+}
+
+template <typename T>
+typename MappedSeqList<T>::size_type MappedSeqList<T>::capacity() const {
+    return static_cast<size_type>(header()->capacity);
+}
+
+template <typename T>
+bool MappedSeqList<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+T* MappedSeqList<T>::data() noexcept {
+    return elements();
+}
+
+template <typename T>
+const T* MappedSeqList<T>::data() const noexcept {
+    return elements();
+}
+
+template <typename T>
+T& MappedSeqList<T>::operator[](size_type pos) {
+    assert(pos < size());
+    return elements()[pos];
+}
+
+template <typename T>
+const T& MappedSeqList<T>::operator[](size_type pos) const {
+    assert(pos < size());
+    return elements()[pos];
+}
+
+template <typename T>
+void MappedSeqList<T>::map(size_type bytes) {
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        throwErrno("MappedSeqList: mmap");
+    }
+    base_ = p;
+    mappedBytes_ = bytes;
+}
+
+// Grows the file first, then the mapping. On Linux mremap extends the
+// mapping in place or moves its pages, never the element bytes.
+template <typename T>
+void MappedSeqList<T>::remap(size_type newCapacity) {
+    size_type bytes = bytesFor(newCapacity);
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+        throwErrno("MappedSeqList: ftruncate");
+    }
+
+#if defined(__linux__)
+    void* p = ::mremap(base_, mappedBytes_, bytes, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) {
+        throwErrno("MappedSeqList: mremap");
+    }
+    base_ = p;
+    mappedBytes_ = bytes;
+#else
+    void* old = base_;
+    size_type oldBytes = mappedBytes_;
+    map(bytes);
+    ::munmap(old, oldBytes);
+#endif
+
+    header()->capacity = newCapacity;
+}
+
+template <typename T>
+void MappedSeqList<T>::ensureCapacity() {
+    if (size() >= capacity()) {
+        remap(capacity() == 0 ? kInitialCapacity : capacity() * 2);
+    }
+}
+
+template <typename T>
+void MappedSeqList<T>::swap(MappedSeqList& other) noexcept {
+    using std::swap;
+    swap(fd_, other.fd_);
+    swap(base_, other.base_);
+    swap(mappedBytes_, other.mappedBytes_);
+}
+
+template <typename T>
+typename MappedSeqList<T>::Header* MappedSeqList<T>::header() const noexcept {
+    assert(base_ != nullptr && "Use of a moved-from MappedSeqList");
+    return static_cast<Header*>(base_);
+}
+
+template <typename T>
+T* MappedSeqList<T>::elements() const noexcept {
+    return reinterpret_cast<T*>(static_cast<unsigned char*>(base_) + kHeaderSize);
+}
+
+template <typename T>
+typename MappedSeqList<T>::size_type MappedSeqList<T>::bytesFor(size_type capacity) noexcept {
+    return kHeaderSize + capacity * sizeof(T);
+}
+
+template <typename T>
+void MappedSeqList<T>::throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+}
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "seq_list.hpp"
+
+namespace ds {
+
+namespace parallel {
+
+using size_type = std::size_t;
+
+// Lists shorter than this are processed on the calling thread; it is also
+// the smallest chunk handed to a worker.
+inline constexpr size_type kSerialCutoff = size_type{1} << 15;
+
+// ThreadPool: a fixed set of workers that run one batch of indexed tasks at
+// a time, together with the thread that submitted the batch.
+class ThreadPool {
+public:
+    // threads is the number of extra workers; the caller of run() is one more
+    explicit ThreadPool(size_type threads = defaultWorkers());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Calls fn(i) for every i in [0, tasks) and returns once all calls are
+    // done, rethrowing the first exception any of them threw. A run() issued
+    // from inside a task executes serially on that thread.
+    template <class F>
+    void run(size_type tasks, F&& fn);
+
+    // Threads that take part in a run(): the workers plus the caller
+    size_type concurrency() const noexcept;
+
+    // The process-wide pool used by the algorithms by default
+    static ThreadPool& instance();
+
+private:
+    struct Batch {
+        void (*invoke)(void*, size_type);
+        void* context;
+        size_type count;
+        std::atomic<size_type> next{0};
+        std::exception_ptr error;
+    };
+
+    static size_type defaultWorkers() noexcept;
+    static bool& insideTask() noexcept;
+
+    void workerLoop();
+    void work(Batch& batch);
+
+private:
+    SeqList<std::thread> workers_;
+    std::mutex runMutex_;           // one batch at a time
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    Batch* batch_ = nullptr;
+    size_type generation_ = 0;
+    size_type active_ = 0;          // workers currently inside work()
+    bool stop_ = false;
+};
+
+inline ThreadPool::ThreadPool(size_type threads) {
+    workers_.reserve(threads);
+    for (size_type i = 0; i < threads; ++i) {
+        workers_.pushBack(std::thread([this] { workerLoop(); }));
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (size_type i = 0; i < workers_.size(); ++i) {
+        workers_[i].join();
+    }
+}
+
+template <class F>
+void ThreadPool::run(size_type tasks, F&& fn) {
+    if (tasks == 0) {
+        return;
+    }
+    if (tasks == 1 || workers_.empty() || insideTask()) {
+        for (size_type i = 0; i < tasks; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    using Fn = std::remove_reference_t<F>;
+    Batch batch;
+    batch.invoke = [](void* context, size_type i) { (*static_cast<Fn*>(context))(i); };
+    batch.context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+    batch.count = tasks;
+
+    std::lock_guard<std::mutex> serialize(runMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch_ = &batch;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    work(batch);
+
+    // Workers may still be finishing their last task or about to look at
+    // the batch: it must outlive every one of them
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return active_ == 0; });
+        batch_ = nullptr;
+    }
+
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+inline size_type ThreadPool::concurrency() const noexcept {
+    return workers_.size() + 1;
+}
+
+inline ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+inline size_type ThreadPool::defaultWorkers() noexcept {
+    size_type hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+inline bool& ThreadPool::insideTask() noexcept {
+    static thread_local bool inside = false;
+    return inside;
+}
+
+inline void ThreadPool::workerLoop() {
+    size_type seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return stop_ || (batch_ != nullptr && generation_ != seen); });
+        if (stop_) {
+            return;
+        }
+        seen = generation_;
+        Batch* batch = batch_;
+        ++active_;
+        lock.unlock();
+
+        work(*batch);
+
+        lock.lock();
+        if (--active_ == 0) {
+            done_.notify_all();
+        }
+    }
+}
+
+inline void ThreadPool::work(Batch& batch) {
+    bool& inside = insideTask();
+    inside = true;
+    for (size_type i; (i = batch.next.fetch_add(1, std::memory_order_relaxed)) < batch.count;) {
+        try {
+            batch.invoke(batch.context, i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!batch.error) {
+                batch.error = std::current_exception();
+            }
+        }
+    }
+    inside = false;
+}
+
+namespace detail {
+
+// Number of chunks to cut n elements into: one per thread, but none
+// smaller than the cutoff
+inline size_type chunkCount(size_type n, const ThreadPool& pool) noexcept {
+    size_type chunks = n / kSerialCutoff;
+    size_type threads = pool.concurrency();
+    if (chunks > threads) {
+        chunks = threads;
+    }
+    return chunks == 0 ? 1 : chunks;
+}
+
+// Calls fn(begin, end) for each of `chunks` contiguous slices of [0, n)
+template <class F>
+void forChunks(ThreadPool& pool, size_type n, size_type chunks, F&& fn) {
+    pool.run(chunks, [&](size_type c) {
+        fn(n * c / chunks, n * (c + 1) / chunks);
+    });
+}
+
+// Sorts each chunk, then merges neighbouring runs pairwise, doubling the
+// run length each round. inplace_merge is stable, so a stable per-chunk
+// sort gives a stable result.
+template <typename T, class Compare, class SortChunk>
+void mergeSort(T* data, size_type n, Compare& comp, ThreadPool& pool, SortChunk sortChunk) {
+    size_type chunks = chunkCount(n, pool);
+    if (chunks == 1) {
+        sortChunk(data, data + n);
+        return;
+    }
+
+    forChunks(pool, n, chunks, [&](size_type begin, size_type end) {
+        sortChunk(data + begin, data + end);
+    });
+
+    for (size_type width = 1; width < chunks; width *= 2) {
+        size_type merges = (chunks + 2 * width - 1) / (2 * width);
+        pool.run(merges, [&](size_type m) {
+            size_type first = 2 * width * m;
+            size_type middle = std::min(first + width, chunks);
+            size_type last = std::min(first + 2 * width, chunks);
+            if (middle == last) {
+                return;
+            }
+            std::inplace_merge(data + n * first / chunks, data + n * middle / chunks,
+                               data + n * last / chunks, comp);
+        });
+    }
+}
+
+} // namespace detail
+
+// Algorithms over the contiguous storage of a SeqList. Element functions are
+// called concurrently and in no particular order.
+
+template <typename T, std::size_t N, class G, class Compare = std::less<>>
+void sort(SeqList<T, N, G>& list, Compare comp = Compare(),
+          ThreadPool& pool = ThreadPool::instance()) {
+    detail::mergeSort(list.data(), list.size(), comp, pool,
+                      [&](T* first, T* last) { std::sort(first, last, comp); });
+}
+
+template <typename T, std::size_t N, class G, class Compare = std::less<>>
+void stableSort(SeqList<T, N, G>& list, Compare comp = Compare(),
+                ThreadPool& pool = ThreadPool::instance()) {
+    detail::mergeSort(list.data(), list.size(), comp, pool,
+                      [&](T* first, T* last) { std::stable_sort(first, last, comp); });
+}
+
+// Replaces every element x with op(x)
+template <typename T, std::size_t N, class G, class UnaryOp>
+void transform(SeqList<T, N, G>& list, UnaryOp op, ThreadPool& pool = ThreadPool::instance()) {
+    T* data = list.data();
+    size_type n = list.size();
+    detail::forChunks(pool, n, detail::chunkCount(n, pool), [&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; ++i) {
+            data[i] = op(std::move(data[i]));
+        }
+    });
+}
+
+template <typename T, std::size_t N, class G, class Function>
+void forEach(SeqList<T, N, G>& list, Function f, ThreadPool& pool = ThreadPool::instance()) {
+    T* data = list.data();
+    size_type n = list.size();
+    detail::forChunks(pool, n, detail::chunkCount(n, pool), [&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; ++i) {
+            f(data[i]);
+        }
+    });
+}
+
+// Folds the elements into init with op, which must be associative; the
+// chunks are combined in list order, so it need not be commutative
+template <typename T, std::size_t N, class G, class BinaryOp = std::plus<>>
+T reduce(const SeqList<T, N, G>& list, T init, BinaryOp op = BinaryOp(),
+         ThreadPool& pool = ThreadPool::instance()) {
+    const T* data = list.data();
+    size_type n = list.size();
+    if (n == 0) {
+        return init;
+    }
+
+    size_type chunks = detail::chunkCount(n, pool);
+    SeqList<T> partials;
+    partials.assign(chunks, data[0]);
+    pool.run(chunks, [&](size_type c) {
+        size_type begin = n * c / chunks;
+        size_type end = n * (c + 1) / chunks;
+        T acc = data[begin];
+        for (size_type i = begin + 1; i < end; ++i) {
+            acc = op(std::move(acc), data[i]);
+        }
+        partials[c] = std::move(acc);
+    });
+
+    for (size_type c = 0; c < chunks; ++c) {
+        init = op(std::move(init), partials[c]);
+    }
+    return init;
+}
+
+template <typename T, std::size_t N, class G, class Predicate>
+size_type countIf(const SeqList<T, N, G>& list, Predicate pred,
+                  ThreadPool& pool = ThreadPool::instance()) {
+    const T* data = list.data();
+    size_type n = list.size();
+    std::atomic<size_type> total{0};
+    detail::forChunks(pool, n, detail::chunkCount(n, pool), [&](size_type begin, size_type end) {
+        size_type count = 0;
+        for (size_type i = begin; i < end; ++i) {
+            if (pred(data[i])) {
+                ++count;
+            }
+        }
+        total.fetch_add(count, std::memory_order_relaxed);
+    });
+    return total.load(std::memory_order_relaxed);
+}
+
+} // namespace parallel
+
+}
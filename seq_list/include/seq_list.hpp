@@ -1,14 +1,57 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
+#include "growth_policy.hpp"
+#include "simd_scan.hpp"
+
 namespace ds{
 
-// SeqList: A standard sequential list
+class Bitmap;
+
+namespace detail {
+
+// Keeps iterator-pair overloads out of the way of (count, value) overloads
+template <class It>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+// InlineStorage: raw space for N elements embedded in a SeqList<T, N>.
+// The N == 0 specialization is empty and costs nothing as a base class.
+template <typename T, std::size_t N>
+struct InlineStorage {
+    T* inlineData() noexcept { return reinterpret_cast<T*>(bytes_); }
+    const T* inlineData() const noexcept { return reinterpret_cast<const T*>(bytes_); }
+
+    alignas(T) unsigned char bytes_[N * sizeof(T)];
+};
+
 template <typename T>
-class SeqList{
+struct InlineStorage<T, 0> {
+    T* inlineData() noexcept { return nullptr; }
+    const T* inlineData() const noexcept { return nullptr; }
+};
+
+} // namespace detail
+
+// SeqList: A standard sequential list.
+// With N > 0 the first N elements live inside the object itself and the
+// list only touches the heap once it outgrows them (see SmallSeqList).
+// Growth is the growth policy (growth_policy.hpp): how far the buffer grows
+// and where its memory comes from.
+template <typename T, std::size_t N = 0, class Growth = GeometricGrowth<>>
+class SeqList : private detail::InlineStorage<T, N> {
 public:
     using size_type = std::size_t;
     static constexpr size_type npos = static_cast<size_type>(-1);
@@ -38,71 +81,144 @@ public:
 
     bool erase(size_type pos);
 
+    // Bulk operations shift the tail once per call and grow at most once.
+    // The source range must not refer to elements of this list.
+    template<class InputIt, class = detail::RequireInputIterator<InputIt>>
+    bool insertRange(size_type pos, InputIt first, InputIt last);
+
+    bool eraseRange(size_type pos, size_type count);
+
+    template<class InputIt, class = detail::RequireInputIterator<InputIt>>
+    void assign(InputIt first, InputIt last);
+    void assign(size_type count, const T& value);
+    void assign(std::initializer_list<T> init);
+
+    void reserve(size_type newCapacity);
+    void shrinkToFit();
+    void clear() noexcept;
+
+    // Scans use SSE2/AVX2 (picked at runtime) for int32_t, uint64_t and
+    // float elements, and operator== otherwise.
     size_type find(const T& value) const noexcept;
+    size_type count(const T& value) const noexcept;
+    Bitmap findAll(const T& value) const;
+
+    // Position of the first element satisfying pred. Passing an InRange<T>
+    // takes the SIMD path where find would.
+    template<class Pred>
+    size_type findIf(Pred pred) const;
 
     void set(size_type pos, const T& value);
 
     size_type size() const;
+    size_type capacity() const;
     bool empty() const;
 
     T& operator[](size_type pos);
     const T& operator[](size_type pos) const;
 
+    // Contiguous storage of the size() elements
+    T* data() noexcept;
+    const T* data() const noexcept;
+
 private:
+    static T* allocate(size_type capacity);
+    static void deallocate(T* data, size_type capacity) noexcept;
+
+    size_type grownCapacity(size_type required) const noexcept;
     void ensureCapacity();
+    void reallocate(size_type newCapacity);
+
+    bool isInline() const noexcept;
+    void releaseStorage() noexcept;
+    void resetStorage() noexcept;
+    void takeStorage(SeqList& other) noexcept;
 
     void swap(SeqList& other) noexcept;
 
     template<class U>
     void insertAt(size_type pos, U&& value);
 
+    template<class ForwardIt>
+    void insertRangeAt(size_type pos, ForwardIt first, size_type count);
+
     void removeAt(size_type pos) noexcept;
 
 private:
     size_type size_ = 0;        // current number of elements
     size_type capacity_ = 0;    // current capacity
-    T* data_ = nullptr;         // pointer to dynamic array
-
-    static constexpr size_type kInitialCapacity = 4;
+    T* data_ = nullptr;         // uninitialized storage, [0, size_) is constructed
 };
 
+// SmallSeqList: a SeqList that holds up to N elements without allocating
+template <typename T, std::size_t N, class Growth = GeometricGrowth<>>
+using SmallSeqList = SeqList<T, N, Growth>;
 
 
-template <typename T>
-SeqList<T>::SeqList()
-    : size_(0), capacity_(kInitialCapacity), data_(new T[kInitialCapacity]) {}
+// Bitmap: one bit per list position, as returned by SeqList::findAll
+class Bitmap {
+public:
+    using size_type = std::size_t;
 
-template <typename T>
-SeqList<T>::~SeqList() {
-    delete[] data_;
+    explicit Bitmap(size_type bits = 0);
+
+    bool test(size_type pos) const;
+    void set(size_type pos);
+
+    size_type count() const noexcept;   // number of set bits
+    size_type size() const noexcept;    // number of bits
+
+    std::uint64_t* words() noexcept;
+    const std::uint64_t* words() const noexcept;
+    size_type wordCount() const noexcept;
+
+private:
+    SeqList<std::uint64_t> words_;
+    size_type bits_ = 0;
+};
+
+
+template <typename T, std::size_t N, class Growth>
+SeqList<T, N, Growth>::SeqList()
+    : size_(0),
+      capacity_(N > 0 ? N : Growth::template nextCapacity<T>(0, 1)),
+      data_(N > 0 ? this->inlineData() : allocate(capacity_)) {}
+
+template <typename T, std::size_t N, class Growth>
+SeqList<T, N, Growth>::~SeqList() {
+    std::destroy(data_, data_ + size_);
+    releaseStorage();
     data_ = nullptr;
     size_ = 0;
     capacity_ = 0;
 }
 
 // Copy constructor
-template <typename T>
-SeqList<T>::SeqList(const SeqList<T>& other)
-    : size_(other.size_), capacity_(other.capacity_), data_(new T[other.capacity_]) {
-    for (size_type i = 0; i < other.size_; ++i) {
-        data_[i] = other.data_[i];
+template <typename T, std::size_t N, class Growth>
+SeqList<T, N, Growth>::SeqList(const SeqList<T, N, Growth>& other)
+    : size_(0),
+      capacity_(other.size_ <= N ? N : other.capacity_),
+      data_(other.size_ <= N ? this->inlineData() : allocate(other.capacity_)) {
+    try {
+        std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+    } catch (...) {
+        releaseStorage();
+        throw;
     }
+    size_ = other.size_;
 }
 
 // Copy assignment operator
-template <typename T>
-SeqList<T>& SeqList<T>::operator=(SeqList<T> other) noexcept {
+template <typename T, std::size_t N, class Growth>
+SeqList<T, N, Growth>& SeqList<T, N, Growth>::operator=(SeqList<T, N, Growth> other) noexcept {
     swap(other);
     return *this;
 }
 
 // Move constructor
-template <typename T>
-SeqList<T>::SeqList(SeqList<T>&& other) noexcept 
-    : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
-    other.data_ = nullptr;
-    other.size_ = 0;
-    other.capacity_ = 0;
+template <typename T, std::size_t N, class Growth>
+SeqList<T, N, Growth>::SeqList(SeqList<T, N, Growth>&& other) noexcept {
+    takeStorage(other);
 }
 
 
@@ -113,63 +229,113 @@ handle both lvalues and rvalues (via move construction), it safely
 replaces the need for a separate move-assignment overload.
 */
 // Move assignment operator
-// template <typename T>
-// SeqList<T>& SeqList<T>::operator=(SeqList<T>&& other) noexcept {
+// template <typename T, std::size_t N, class Growth>
+// SeqList<T, N, Growth>& SeqList<T, N, Growth>::operator=(SeqList<T, N, Growth>&& other) noexcept {
 //     swap(other);
 //     return *this;
 // }
 
-template <typename T>
-void SeqList<T>::ensureCapacity() {
+// Storage comes from the growth policy as raw memory rather than new T[],
+// so that no slot is constructed before it is used, and so that trivially
+// relocatable types can grow in place (realloc, mremap).
+template <typename T, std::size_t N, class Growth>
+T* SeqList<T, N, Growth>::allocate(size_type capacity) {
+    return Growth::template allocate<T>(capacity);
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::deallocate(T* data, size_type capacity) noexcept {
+    Growth::template deallocate<T>(data, capacity);
+}
+
+// Next capacity in the policy's sequence that holds `required` elements
+template <typename T, std::size_t N, class Growth>
+typename SeqList<T, N, Growth>::size_type SeqList<T, N, Growth>::grownCapacity(size_type required) const noexcept {
+    return Growth::template nextCapacity<T>(capacity_, required);
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::ensureCapacity() {
     if (size_ >= capacity_) {
-        // Double the capacity (or use initial capacity if capacity_ is 0)
-        size_type newCapacity = capacity_ == 0 ? kInitialCapacity : capacity_ * 2;
+        reallocate(grownCapacity(size_ + 1));
+    }
+}
+
+// Moves the live elements into a buffer of newCapacity slots.
+// Requires newCapacity >= size_ and newCapacity > 0.
+// A capacity that fits the inline buffer moves the elements back into it.
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::reallocate(size_type newCapacity) {
+    assert(newCapacity >= size_ && newCapacity > 0);
 
-        // allocate a new array with the new capacity
-        T* newData = new T[newCapacity];
+    const bool toInline = N > 0 && newCapacity <= N;
+    if (toInline && isInline()) {
+        return;
+    }
 
-        // Copy existing elements to the new array
-        for (size_type i = 0; i < size_; ++i) {
-            newData[i] = data_[i];
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (!toInline && !isInline()) {
+            // The policy moves the bytes: realloc, or remapping the pages
+            data_ = Growth::template reallocate<T>(data_, capacity_, newCapacity);
+            capacity_ = newCapacity;
+            return;
         }
+    }
 
-        // Release the old array and update the internol pointers
-        delete[] data_;
-        data_ = newData;
-        capacity_ = newCapacity;
+    T* newData = toInline ? this->inlineData() : allocate(newCapacity);
+    try {
+        // Fall back to copying when a throwing move could lose elements
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(data_, data_ + size_, newData);
+        } else {
+            std::uninitialized_copy(data_, data_ + size_, newData);
+        }
+    } catch (...) {
+        if (!toInline) {
+            deallocate(newData, newCapacity);
+        }
+        throw;
     }
+
+    // Release the old array and update the internal pointers
+    std::destroy(data_, data_ + size_);
+    releaseStorage();
+    data_ = newData;
+    capacity_ = toInline ? N : newCapacity;
 }
 
-template<typename T>
+template <typename T, std::size_t N, class Growth>
 template<class U>
-void SeqList<T>::pushBack(U&& value)
+void SeqList<T, N, Growth>::pushBack(U&& value)
 {
     insertAt(size_, std::forward<U>(value));
 }
 
-template<typename T>
+template <typename T, std::size_t N, class Growth>
 template<class U>
-void SeqList<T>::pushFront(U&& value)
+void SeqList<T, N, Growth>::pushFront(U&& value)
 {
     insertAt(0, std::forward<U>(value)); 
 }
 
-template <typename T>
-void SeqList<T>::popBack() {
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::popBack() {
     assert(size_ > 0 && "Cannot pop from an empty list.");
     --size_;
+    std::destroy_at(data_ + size_);
 }
 
-template <typename T>
-void SeqList<T>::popFront() {
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::popFront() {
     assert(size_ > 0 && "Cannot pop from an empty list.");
 
     removeAt(0);
 }
 
-template<typename T>
+template <typename T, std::size_t N, class Growth>
 template<class U>
-bool SeqList<T>::insert(size_type pos, U&& value)
+bool SeqList<T, N, Growth>::insert(size_type pos, U&& value)
 {
     if (pos > size_) {
         return false;
@@ -178,8 +344,8 @@ bool SeqList<T>::insert(size_type pos, U&& value)
     return true;
 }
 
-template<typename T>
-bool SeqList<T>::erase(size_type pos)
+template <typename T, std::size_t N, class Growth>
+bool SeqList<T, N, Growth>::erase(size_type pos)
 {
     if (pos >= size_) {
         return false;
@@ -188,78 +354,389 @@ bool SeqList<T>::erase(size_type pos)
     return true;
 }
 
+template <typename T, std::size_t N, class Growth>
+template<class InputIt, class>
+bool SeqList<T, N, Growth>::insertRange(size_type pos, InputIt first, InputIt last)
+{
+    if (pos > size_) {
+        return false;
+    }
 
-template <typename T>
-typename SeqList<T>::size_type SeqList<T>::find(const T& value) const noexcept {
-    for (size_type i = 0; i < size_; ++i) {
-        if (data_[i] == value) {
-            return i; 
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+        insertRangeAt(pos, first, static_cast<size_type>(std::distance(first, last)));
+    } else if (pos == size_) {
+        for (; first != last; ++first) {
+            insertAt(size_, *first);
+        }
+    } else {
+        // A single-pass range has no length up front: buffer it so the
+        // tail is still shifted only once
+        SeqList buffer;
+        for (; first != last; ++first) {
+            buffer.pushBack(*first);
         }
+        insertRangeAt(pos, std::make_move_iterator(buffer.data_), buffer.size_);
     }
-    return npos;
+    return true;
 }
 
-template <typename T>
-void SeqList<T>::set(size_type pos, const T& value) {
+template <typename T, std::size_t N, class Growth>
+bool SeqList<T, N, Growth>::eraseRange(size_type pos, size_type count)
+{
+    if (pos > size_) {
+        return false;
+    }
+    if (count > size_ - pos) {
+        count = size_ - pos;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    if constexpr (is_trivially_relocatable_v<T>) {
+        std::destroy(data_ + pos, data_ + pos + count);
+        std::memmove(static_cast<void*>(data_ + pos), data_ + pos + count,
+                     (size_ - pos - count) * sizeof(T));
+    } else {
+        std::move(data_ + pos + count, data_ + size_, data_ + pos);
+        std::destroy(data_ + size_ - count, data_ + size_);
+    }
+    size_ -= count;
+    return true;
+}
+
+template <typename T, std::size_t N, class Growth>
+template<class InputIt, class>
+void SeqList<T, N, Growth>::assign(InputIt first, InputIt last)
+{
+    clear();
+    insertRange(0, first, last);
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::assign(size_type count, const T& value)
+{
+    T tmp(value);   // value may be an element of this list
+    clear();
+    reserve(count);
+    std::uninitialized_fill_n(data_, count, tmp);
+    size_ = count;
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::assign(std::initializer_list<T> init)
+{
+    assign(init.begin(), init.end());
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::reserve(size_type newCapacity) {
+    if (newCapacity > capacity_) {
+        reallocate(newCapacity);
+    }
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::shrinkToFit() {
+    if (capacity_ == size_ || isInline()) {
+        return;
+    }
+    if (size_ == 0 && N == 0) {
+        deallocate(data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+        return;
+    }
+    reallocate(size_ < N ? N : size_);
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::clear() noexcept {
+    std::destroy(data_, data_ + size_);
+    size_ = 0;
+}
+
+template <typename T, std::size_t N, class Growth>
+typename SeqList<T, N, Growth>::size_type SeqList<T, N, Growth>::find(const T& value) const noexcept {
+    detail::simd::FirstMatch sink;
+    detail::simd::scan(data_, size_, detail::simd::EqualTo<T>{value}, sink);
+    return sink.pos;
+}
+
+template <typename T, std::size_t N, class Growth>
+typename SeqList<T, N, Growth>::size_type SeqList<T, N, Growth>::count(const T& value) const noexcept {
+    detail::simd::CountMatches sink;
+    detail::simd::scan(data_, size_, detail::simd::EqualTo<T>{value}, sink);
+    return sink.count;
+}
+
+template <typename T, std::size_t N, class Growth>
+Bitmap SeqList<T, N, Growth>::findAll(const T& value) const {
+    Bitmap positions(size_);
+    detail::simd::MarkMatches sink{positions.words()};
+    detail::simd::scan(data_, size_, detail::simd::EqualTo<T>{value}, sink);
+    return positions;
+}
+
+template <typename T, std::size_t N, class Growth>
+template <class Pred>
+typename SeqList<T, N, Growth>::size_type SeqList<T, N, Growth>::findIf(Pred pred) const {
+    detail::simd::FirstMatch sink;
+    detail::simd::scan(data_, size_, pred, sink);
+    return sink.pos;
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::set(size_type pos, const T& value) {
     assert(pos < size_);
     data_[pos] = value;
 }
 
-template <typename T>
-typename SeqList<T>::size_type SeqList<T>::size() const {
+template <typename T, std::size_t N, class Growth>
+typename SeqList<T, N, Growth>::size_type SeqList<T, N, Growth>::size() const {
     return size_;
 }
 
-template <typename T>
-bool SeqList<T>::empty() const {
+template <typename T, std::size_t N, class Growth>
+typename SeqList<T, N, Growth>::size_type SeqList<T, N, Growth>::capacity() const {
+    return capacity_;
+}
+
+template <typename T, std::size_t N, class Growth>
+bool SeqList<T, N, Growth>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-T& SeqList<T>::operator[](size_type pos) {
+template <typename T, std::size_t N, class Growth>
+T& SeqList<T, N, Growth>::operator[](size_type pos) {
     assert(pos < size_);
     return data_[pos];
 }
 
-template <typename T>
-const T& SeqList<T>::operator[](size_type pos) const {
+template <typename T, std::size_t N, class Growth>
+const T& SeqList<T, N, Growth>::operator[](size_type pos) const {
     assert(pos < size_);
     return data_[pos];
 }
 
+template <typename T, std::size_t N, class Growth>
+T* SeqList<T, N, Growth>::data() noexcept {
+    return data_;
+}
+
+template <typename T, std::size_t N, class Growth>
+const T* SeqList<T, N, Growth>::data() const noexcept {
+    return data_;
+}
+
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::swap(SeqList& other) noexcept {
+    if (isInline() || other.isInline()) {
+        // Inline elements cannot change owner by swapping pointers
+        SeqList tmp(std::move(other));
+        other.takeStorage(*this);
+        takeStorage(tmp);
+        return;
+    }
 
-template <typename T>
-void SeqList<T>::swap(SeqList& other) noexcept {
     using std::swap;
     swap(data_, other.data_);
     swap(size_, other.size_);
     swap(capacity_, other.capacity_);
 }
 
-template<typename T>
+template <typename T, std::size_t N, class Growth>
+bool SeqList<T, N, Growth>::isInline() const noexcept {
+    return N > 0 && data_ == this->inlineData();
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::releaseStorage() noexcept {
+    if (!isInline()) {
+        deallocate(data_, capacity_);
+    }
+}
+
+// Back to the state of a moved-from list: empty, on the inline buffer if
+// there is one and without any storage otherwise
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::resetStorage() noexcept {
+    data_ = this->inlineData();
+    size_ = 0;
+    capacity_ = N;
+}
+
+// Takes over other's elements. *this must hold no elements and no heap
+// storage; other is left reset.
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::takeStorage(SeqList& other) noexcept {
+    if (other.isInline()) {
+        std::uninitialized_move(other.data_, other.data_ + other.size_, this->inlineData());
+        std::destroy(other.data_, other.data_ + other.size_);
+        data_ = this->inlineData();
+    } else {
+        data_ = other.data_;
+    }
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.resetStorage();
+}
+
+template <typename T, std::size_t N, class Growth>
 template<class U>
-void SeqList<T>::insertAt(size_type pos, U&& value)
+void SeqList<T, N, Growth>::insertAt(size_type pos, U&& value)
 {
     assert(pos <= size_);
-    ensureCapacity(); 
 
-    for (size_type i = size_; i > pos; --i) {
-        data_[i] = std::move_if_noexcept(data_[i - 1]);
+    // Fast path: appending into spare capacity constructs in place
+    if (pos == size_ && size_ < capacity_) {
+        ::new (static_cast<void*>(data_ + size_)) T(std::forward<U>(value));
+        ++size_;
+        return;
     }
 
-    data_[pos] = std::forward<U>(value);
+    // value may refer to an element of this list, so materialize it
+    // before growth or shifting can move that element away
+    T tmp(std::forward<U>(value));
+    ensureCapacity();
+
+    if (pos == size_) {
+        ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
+    } else {
+        // The last element moves into the raw slot, the rest shift by assignment
+        ::new (static_cast<void*>(data_ + size_)) T(std::move(data_[size_ - 1]));
+        std::move_backward(data_ + pos, data_ + size_ - 1, data_ + size_);
+        data_[pos] = std::move(tmp);
+    }
     ++size_;
 }
 
-template<typename T>
-void SeqList<T>::removeAt(size_type pos) noexcept
+// Opens a gap of `count` slots at pos and fills it from [first, first + count).
+template <typename T, std::size_t N, class Growth>
+template<class ForwardIt>
+void SeqList<T, N, Growth>::insertRangeAt(size_type pos, ForwardIt first, size_type count)
 {
-    assert(pos < size_);
+    assert(pos <= size_);
+    if (count == 0) {
+        return;
+    }
+
+    if (capacity_ - size_ < count) {
+        // Grow once and build the result directly in the new buffer:
+        // new elements first, then the old ones relocated around them
+        size_type newCapacity = grownCapacity(size_ + count);
+        T* newData = allocate(newCapacity);
+        try {
+            std::uninitialized_copy_n(first, count, newData + pos);
+        } catch (...) {
+            deallocate(newData, newCapacity);
+            throw;
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (size_ != 0) {
+                std::memcpy(static_cast<void*>(newData), data_, pos * sizeof(T));
+                std::memcpy(static_cast<void*>(newData + pos + count), data_ + pos,
+                            (size_ - pos) * sizeof(T));
+            }
+        } else {
+            // Elements are moved, so a throwing move constructor gives only
+            // the basic guarantee here
+            std::uninitialized_move(data_, data_ + pos, newData);
+            std::uninitialized_move(data_ + pos, data_ + size_, newData + pos + count);
+            std::destroy(data_, data_ + size_);
+        }
+        releaseStorage();
+        data_ = newData;
+        capacity_ = newCapacity;
+        size_ += count;
+        return;
+    }
+
+    T* end = data_ + size_;
+    size_type after = size_ - pos;
 
-    for (size_type i = pos + 1; i < size_; ++i) {
-        data_[i - 1] = std::move_if_noexcept(data_[i]);
+    if constexpr (is_trivially_relocatable_v<T>) {
+        std::memmove(static_cast<void*>(data_ + pos + count), data_ + pos, after * sizeof(T));
+        try {
+            std::uninitialized_copy_n(first, count, data_ + pos);
+        } catch (...) {
+            std::memmove(static_cast<void*>(data_ + pos), data_ + pos + count, after * sizeof(T));
+            throw;
+        }
+        size_ += count;
+    } else if (after > count) {
+        // The last `count` elements move into raw slots, the rest of the
+        // tail shifts by assignment and the gap is overwritten
+        std::uninitialized_move(end - count, end, end);
+        size_ += count;
+        std::move_backward(data_ + pos, end - count, end);
+        std::copy_n(first, count, data_ + pos);
+    } else {
+        // The gap reaches past the old end: the part of the range beyond it
+        // is constructed in raw slots, the tail moves behind it, and the
+        // rest of the range overwrites the vacated tail
+        ForwardIt mid = std::next(first, static_cast<std::ptrdiff_t>(after));
+        std::uninitialized_copy_n(mid, count - after, end);
+        size_ += count - after;
+        std::uninitialized_move(data_ + pos, end, data_ + pos + count);
+        size_ += after;
+        std::copy(first, mid, data_ + pos);
     }
+}
+
+template <typename T, std::size_t N, class Growth>
+void SeqList<T, N, Growth>::removeAt(size_type pos) noexcept
+{
+    assert(pos < size_);
+
+    std::move(data_ + pos + 1, data_ + size_, data_ + pos);
     --size_;
+    std::destroy_at(data_ + size_);
+}
+
+
+inline Bitmap::Bitmap(size_type bits)
+    : bits_(bits) {
+    words_.assign((bits + 63) / 64, 0);
+}
+
+inline bool Bitmap::test(size_type pos) const {
+    assert(pos < bits_);
+    return (words_[pos / 64] >> (pos % 64)) & 1u;
+}
+
+inline void Bitmap::set(size_type pos) {
+    assert(pos < bits_);
+    words_[pos / 64] |= std::uint64_t{1} << (pos % 64);
+}
+
+inline Bitmap::size_type Bitmap::count() const noexcept {
+    size_type total = 0;
+    for (size_type i = 0; i < words_.size(); ++i) {
+        for (std::uint64_t w = words_[i]; w != 0; w &= w - 1) {
+            ++total;
+        }
+    }
+    return total;
+}
+
+inline Bitmap::size_type Bitmap::size() const noexcept {
+    return bits_;
+}
+
+inline std::uint64_t* Bitmap::words() noexcept {
+    return words_.size() == 0 ? nullptr : &words_[0];
+}
+
+inline const std::uint64_t* Bitmap::words() const noexcept {
+    return words_.size() == 0 ? nullptr : &words_[0];
+}
+
+inline Bitmap::size_type Bitmap::wordCount() const noexcept {
+    return words_.size();
 }
 
 }
\ No newline at end of file
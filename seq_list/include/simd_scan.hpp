@@ -0,0 +1,356 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#define DS_SIMD_AVX2 __attribute__((target("avx2")))
+#else
+#define DS_SIMD_X86 0
+#endif
+
+namespace ds {
+
+// InRange: matches lo <= x <= hi. findIf recognizes it and scans with SIMD
+// for the element types that have a vector path.
+template <typename T>
+struct InRange {
+    T lo;
+    T hi;
+
+    constexpr bool operator()(const T& x) const noexcept {
+        return lo <= x && x <= hi;
+    }
+};
+
+namespace detail::simd {
+
+// EqualTo: the predicate behind find/count/findAll
+template <typename T>
+struct EqualTo {
+    const T& value;
+
+    bool operator()(const T& x) const noexcept {
+        return x == value;
+    }
+};
+
+inline unsigned countTrailingZeros(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    for (; (mask & 1u) == 0; mask >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline unsigned popCount(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+    unsigned n = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Sinks receive (index of the first element of a block, bit mask of matches
+// in that block) and return false to stop the scan. Vector blocks hold at
+// most 16 elements and start at multiples of their size, so a block never
+// straddles two 64-bit bitmap words.
+struct FirstMatch {
+    std::size_t pos = static_cast<std::size_t>(-1);
+
+    bool operator()(std::size_t base, std::uint32_t mask) noexcept {
+        pos = base + countTrailingZeros(mask);
+        return false;
+    }
+};
+
+struct CountMatches {
+    std::size_t count = 0;
+
+    bool operator()(std::size_t, std::uint32_t mask) noexcept {
+        count += popCount(mask);
+        return true;
+    }
+};
+
+struct MarkMatches {
+    std::uint64_t* words;
+
+    bool operator()(std::size_t base, std::uint32_t mask) noexcept {
+        words[base / 64] |= static_cast<std::uint64_t>(mask) << (base % 64);
+        return true;
+    }
+};
+
+template <typename T, typename Pred, typename Sink>
+void scanScalar(const T* data, std::size_t first, std::size_t n, const Pred& pred, Sink& sink) {
+    for (std::size_t i = first; i < n; ++i) {
+        if (pred(data[i]) && !sink(i, 1u)) {
+            return;
+        }
+    }
+}
+
+template <typename T>
+inline constexpr bool kVectorType = std::is_same_v<T, std::int32_t> ||
+                                    std::is_same_v<T, std::uint64_t> ||
+                                    std::is_same_v<T, float>;
+
+template <typename Pred>
+struct IsEqualTo : std::false_type {};
+template <typename T>
+struct IsEqualTo<EqualTo<T>> : std::true_type {};
+
+template <typename Pred>
+struct IsInRange : std::false_type {};
+template <typename T>
+struct IsInRange<InRange<T>> : std::true_type {};
+
+template <typename T, typename Pred>
+inline constexpr bool kVectorizable = DS_SIMD_X86 && kVectorType<T> &&
+                                      (IsEqualTo<Pred>::value || IsInRange<Pred>::value);
+
+#if DS_SIMD_X86
+
+inline bool hasAvx2() noexcept {
+    static const bool avx2 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return avx2;
+}
+
+// Per-ISA, per-type vector operations. eq and inRange return one mask bit
+// per lane.
+template <typename T>
+struct Sse2;
+
+template <>
+struct Sse2<std::int32_t> {
+    using Vec = __m128i;
+    static constexpr std::size_t kLanes = 4;
+
+    static Vec load(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+    static Vec splat(std::int32_t v) { return _mm_set1_epi32(v); }
+
+    static std::uint32_t eq(Vec x, Vec v) {
+        return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, v))));
+    }
+    static std::uint32_t inRange(Vec x, Vec lo, Vec hi) {
+        Vec out = _mm_or_si128(_mm_cmplt_epi32(x, lo), _mm_cmpgt_epi32(x, hi));
+        return ~static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(out))) & 0xFu;
+    }
+};
+
+template <>
+struct Sse2<std::uint64_t> {
+    using Vec = __m128i;
+    static constexpr std::size_t kLanes = 2;
+
+    static Vec load(const std::uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+    static Vec splat(std::uint64_t v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+
+    // SSE2 has no 64-bit compares: combine the 32-bit halves
+    static std::uint32_t eq(Vec x, Vec v) {
+        Vec e = _mm_cmpeq_epi32(x, v);
+        e = _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(e)));
+    }
+    static Vec greater(Vec a, Vec b) {
+        const Vec sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        Vec gt = _mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+        Vec e = _mm_cmpeq_epi32(a, b);
+        Vec gtHigh = _mm_shuffle_epi32(gt, _MM_SHUFFLE(3, 3, 1, 1));
+        Vec gtLow = _mm_shuffle_epi32(gt, _MM_SHUFFLE(2, 2, 0, 0));
+        Vec eqHigh = _mm_shuffle_epi32(e, _MM_SHUFFLE(3, 3, 1, 1));
+        return _mm_or_si128(gtHigh, _mm_and_si128(eqHigh, gtLow));
+    }
+    static std::uint32_t inRange(Vec x, Vec lo, Vec hi) {
+        Vec out = _mm_or_si128(greater(lo, x), greater(x, hi));
+        return ~static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(out))) & 0x3u;
+    }
+};
+
+template <>
+struct Sse2<float> {
+    using Vec = __m128;
+    static constexpr std::size_t kLanes = 4;
+
+    static Vec load(const float* p) { return _mm_loadu_ps(p); }
+    static Vec splat(float v) { return _mm_set1_ps(v); }
+
+    static std::uint32_t eq(Vec x, Vec v) {
+        return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(x, v)));
+    }
+    static std::uint32_t inRange(Vec x, Vec lo, Vec hi) {
+        return static_cast<std::uint32_t>(
+            _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(lo, x), _mm_cmple_ps(x, hi))));
+    }
+};
+
+template <typename T>
+struct Avx2;
+
+template <>
+struct Avx2<std::int32_t> {
+    using Vec = __m256i;
+    static constexpr std::size_t kLanes = 8;
+
+    DS_SIMD_AVX2 static Vec load(const std::int32_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p));
+    }
+    DS_SIMD_AVX2 static Vec splat(std::int32_t v) { return _mm256_set1_epi32(v); }
+
+    DS_SIMD_AVX2 static std::uint32_t eq(Vec x, Vec v) {
+        return static_cast<std::uint32_t>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, v))));
+    }
+    DS_SIMD_AVX2 static std::uint32_t inRange(Vec x, Vec lo, Vec hi) {
+        Vec out = _mm256_or_si256(_mm256_cmpgt_epi32(lo, x), _mm256_cmpgt_epi32(x, hi));
+        return ~static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(out))) & 0xFFu;
+    }
+};
+
+template <>
+struct Avx2<std::uint64_t> {
+    using Vec = __m256i;
+    static constexpr std::size_t kLanes = 4;
+
+    DS_SIMD_AVX2 static Vec load(const std::uint64_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p));
+    }
+    DS_SIMD_AVX2 static Vec splat(std::uint64_t v) {
+        return _mm256_set1_epi64x(static_cast<long long>(v));
+    }
+
+    DS_SIMD_AVX2 static std::uint32_t eq(Vec x, Vec v) {
+        return static_cast<std::uint32_t>(
+            _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, v))));
+    }
+    // Only signed 64-bit compares exist: flip the sign bits first
+    DS_SIMD_AVX2 static std::uint32_t inRange(Vec x, Vec lo, Vec hi) {
+        const Vec sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+        Vec sx = _mm256_xor_si256(x, sign);
+        Vec out = _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_xor_si256(lo, sign), sx),
+                                  _mm256_cmpgt_epi64(sx, _mm256_xor_si256(hi, sign)));
+        return ~static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(out))) & 0xFu;
+    }
+};
+
+template <>
+struct Avx2<float> {
+    using Vec = __m256;
+    static constexpr std::size_t kLanes = 8;
+
+    DS_SIMD_AVX2 static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    DS_SIMD_AVX2 static Vec splat(float v) { return _mm256_set1_ps(v); }
+
+    DS_SIMD_AVX2 static std::uint32_t eq(Vec x, Vec v) {
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(x, v, _CMP_EQ_OQ)));
+    }
+    DS_SIMD_AVX2 static std::uint32_t inRange(Vec x, Vec lo, Vec hi) {
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(
+            _mm256_and_ps(_mm256_cmp_ps(lo, x, _CMP_LE_OQ), _mm256_cmp_ps(x, hi, _CMP_LE_OQ))));
+    }
+};
+
+// The two block loops are identical apart from the target attribute, which
+// is what lets the AVX2 operations inline. Each iteration tests two vectors
+// (8 to 16 elements) and hands the combined mask to the sink.
+template <typename T, typename Pred, typename Sink>
+void scanSse2(const T* data, std::size_t n, const Pred& pred, Sink& sink) {
+    using Ops = Sse2<T>;
+    using Vec = typename Ops::Vec;
+    constexpr std::size_t kLanes = Ops::kLanes;
+    constexpr bool kEqual = IsEqualTo<Pred>::value;
+
+    Vec a, b;
+    if constexpr (kEqual) {
+        a = b = Ops::splat(pred.value);
+    } else {
+        a = Ops::splat(pred.lo);
+        b = Ops::splat(pred.hi);
+    }
+
+    std::size_t i = 0;
+    for (; i + 2 * kLanes <= n; i += 2 * kLanes) {
+        Vec x0 = Ops::load(data + i);
+        Vec x1 = Ops::load(data + i + kLanes);
+        std::uint32_t mask;
+        if constexpr (kEqual) {
+            mask = Ops::eq(x0, a) | (Ops::eq(x1, a) << kLanes);
+        } else {
+            mask = Ops::inRange(x0, a, b) | (Ops::inRange(x1, a, b) << kLanes);
+        }
+        if (mask != 0 && !sink(i, mask)) {
+            return;
+        }
+    }
+    scanScalar(data, i, n, pred, sink);
+}
+
+template <typename T, typename Pred, typename Sink>
+DS_SIMD_AVX2 void scanAvx2(const T* data, std::size_t n, const Pred& pred, Sink& sink) {
+    using Ops = Avx2<T>;
+    using Vec = typename Ops::Vec;
+    constexpr std::size_t kLanes = Ops::kLanes;
+    constexpr bool kEqual = IsEqualTo<Pred>::value;
+
+    Vec a, b;
+    if constexpr (kEqual) {
+        a = b = Ops::splat(pred.value);
+    } else {
+        a = Ops::splat(pred.lo);
+        b = Ops::splat(pred.hi);
+    }
+
+    std::size_t i = 0;
+    for (; i + 2 * kLanes <= n; i += 2 * kLanes) {
+        Vec x0 = Ops::load(data + i);
+        Vec x1 = Ops::load(data + i + kLanes);
+        std::uint32_t mask;
+        if constexpr (kEqual) {
+            mask = Ops::eq(x0, a) | (Ops::eq(x1, a) << kLanes);
+        } else {
+            mask = Ops::inRange(x0, a, b) | (Ops::inRange(x1, a, b) << kLanes);
+        }
+        if (mask != 0 && !sink(i, mask)) {
+            return;
+        }
+    }
+    scanScalar(data, i, n, pred, sink);
+}
+
+#endif // DS_SIMD_X86
+
+// Feeds every element of [data, data + n) matching pred to sink, using the
+// widest vector path the CPU supports when one exists for (T, Pred).
+template <typename T, typename Pred, typename Sink>
+void scan(const T* data, std::size_t n, const Pred& pred, Sink& sink) {
+#if DS_SIMD_X86
+    if constexpr (kVectorizable<T, Pred>) {
+        if (hasAvx2()) {
+            scanAvx2(data, n, pred, sink);
+        } else {
+            scanSse2(data, n, pred, sink);
+        }
+        return;
+    }
+#endif
+    scanScalar(data, 0, n, pred, sink);
+}
+
+} // namespace detail::simd
+
+} // namespace ds
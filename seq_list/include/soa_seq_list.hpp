@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "seq_list.hpp"
+
+namespace ds {
+
+// SoASeqList: a sequential list of records stored as a structure of arrays.
+//
+// Each field is a SeqList column of its own, so a scan over one field reads
+// only that field's bytes, contiguously. column<I>() exposes the raw array
+// for hand-written or auto-vectorized loops; columnList<I>() exposes the
+// SeqList itself for its SIMD find/count/findIf and the parallel algorithms.
+// Rows are read and written through proxy references from operator[].
+template <typename... Fields>
+class SoASeqList {
+    static_assert(sizeof...(Fields) > 0, "SoASeqList needs at least one field");
+
+public:
+    using size_type = std::size_t;
+    using value_type = std::tuple<Fields...>;
+
+    template <size_type I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type kFieldCount = sizeof...(Fields);
+
+    class Reference;
+    class ConstReference;
+
+    void pushBack(Fields... values);
+    void pushBack(const value_type& row);
+    void popBack();
+
+    bool insert(size_type pos, Fields... values);
+    bool insert(size_type pos, const value_type& row);
+    bool erase(size_type pos);
+
+    void set(size_type pos, const value_type& row);
+
+    void reserve(size_type newCapacity);
+    void clear() noexcept;
+
+    size_type size() const;
+    bool empty() const;
+
+    Reference operator[](size_type pos);
+    ConstReference operator[](size_type pos) const;
+
+    // Contiguous array of field I, valid until the next size change
+    template <size_type I>
+    field_type<I>* column() noexcept;
+    template <size_type I>
+    const field_type<I>* column() const noexcept;
+
+    template <size_type I>
+    const SeqList<field_type<I>>& columnList() const noexcept;
+
+    // Position of the first row whose field I equals value
+    template <size_type I>
+    size_type find(const field_type<I>& value) const noexcept;
+
+private:
+    using Indices = std::index_sequence_for<Fields...>;
+
+    // Grows every column together before a row is added, so that adding it
+    // allocates nothing
+    void ensureCapacity();
+
+    template <std::size_t... Is>
+    void pushBackRow(std::index_sequence<Is...>, Fields&... values);
+    template <std::size_t... Is>
+    void insertRow(size_type pos, std::index_sequence<Is...>, Fields&... values);
+    template <std::size_t... Is>
+    value_type load(size_type pos, std::index_sequence<Is...>) const;
+    template <std::size_t... Is>
+    void store(size_type pos, const value_type& row, std::index_sequence<Is...>);
+
+private:
+    std::tuple<SeqList<Fields>...> columns_;
+};
+
+// Proxy for one row. Assigning to it writes every field of the row;
+// converting it reads the row into a tuple.
+template <typename... Fields>
+class SoASeqList<Fields...>::Reference {
+public:
+    Reference(const Reference&) = default;
+
+    template <size_type I>
+    field_type<I>& get() const {
+        return list_->template column<I>()[pos_];
+    }
+
+    operator value_type() const {
+        return list_->load(pos_, Indices{});
+    }
+
+    Reference& operator=(const value_type& row) {
+        list_->store(pos_, row, Indices{});
+        return *this;
+    }
+
+    Reference& operator=(const Reference& other) {
+        return *this = static_cast<value_type>(other);
+    }
+
+private:
+    friend class SoASeqList;
+
+    Reference(SoASeqList* list, size_type pos) : list_(list), pos_(pos) {}
+
+    SoASeqList* list_;
+    size_type pos_;
+};
+
+template <typename... Fields>
+class SoASeqList<Fields...>::ConstReference {
+public:
+    template <size_type I>
+    const field_type<I>& get() const {
+        return list_->template column<I>()[pos_];
+    }
+
+    operator value_type() const {
+        return list_->load(pos_, Indices{});
+    }
+
+private:
+    friend class SoASeqList;
+
+    ConstReference(const SoASeqList* list, size_type pos) : list_(list), pos_(pos) {}
+
+    const SoASeqList* list_;
+    size_type pos_;
+};
+
+template <typename... Fields>
+void SoASeqList<Fields...>::pushBack(Fields... values) {
+    ensureCapacity();
+    pushBackRow(Indices{}, values...);
+}
+
+template <typename... Fields>
+void SoASeqList<Fields...>::pushBack(const value_type& row) {
+    std::apply([this](const Fields&... values) { pushBack(values...); }, row);
+}
+
+template <typename... Fields>
+void SoASeqList<Fields...>::popBack() {
+    assert(size() > 0 && "Cannot pop from an empty list.");
+    std::apply([](SeqList<Fields>&... columns) { (columns.popBack(), ...); }, columns_);
+}
+
+template <typename... Fields>
+bool SoASeqList<Fields...>::insert(size_type pos, Fields... values) {
+    if (pos > size()) {
+        return false;
+    }
+    ensureCapacity();
+    insertRow(pos, Indices{}, values...);
+    return true;
+}
+
+template <typename... Fields>
+bool SoASeqList<Fields...>::insert(size_type pos, const value_type& row) {
+    return std::apply([&](const Fields&... values) { return insert(pos, values...); }, row);
+}
+
+template <typename... Fields>
+bool SoASeqList<Fields...>::erase(size_type pos) {
+    if (pos >= size()) {
+        return false;
+    }
+    std::apply([pos](SeqList<Fields>&... columns) { (columns.erase(pos), ...); }, columns_);
+    return true;
+}
+
+template <typename... Fields>
+void SoASeqList<Fields...>::set(size_type pos, const value_type& row) {
+    assert(pos < size());
+    store(pos, row, Indices{});
+}
+
+template <typename... Fields>
+void SoASeqList<Fields...>::reserve(size_type newCapacity) {
+    std::apply([newCapacity](SeqList<Fields>&... columns) { (columns.reserve(newCapacity), ...); },
+               columns_);
+}
+
+template <typename... Fields>
+void SoASeqList<Fields...>::clear() noexcept {
+    std::apply([](SeqList<Fields>&... columns) { (columns.clear(), ...); }, columns_);
+}
+
+// All columns always have the same length; the first one speaks for them
+template <typename... Fields>
+typename SoASeqList<Fields...>::size_type SoASeqList<Fields...>::size() const {
+    return std::get<0>(columns_).size();
+}
+
+template <typename... Fields>
+bool SoASeqList<Fields...>::empty() const {
+    return size() == 0;
+}
+
+template <typename... Fields>
+typename SoASeqList<Fields...>::Reference SoASeqList<Fields...>::operator[](size_type pos) {
+    assert(pos < size());
+    return Reference(this, pos);
+}
+
+template <typename... Fields>
+typename SoASeqList<Fields...>::ConstReference
+SoASeqList<Fields...>::operator[](size_type pos) const {
+    assert(pos < size());
+    return ConstReference(this, pos);
+}
+
+template <typename... Fields>
+template <std::size_t I>
+typename SoASeqList<Fields...>::template field_type<I>* SoASeqList<Fields...>::column() noexcept {
+    return std::get<I>(columns_).data();
+}
+
+template <typename... Fields>
+template <std::size_t I>
+const typename SoASeqList<Fields...>::template field_type<I>*
+SoASeqList<Fields...>::column() const noexcept {
+    return std::get<I>(columns_).data();
+}
+
+template <typename... Fields>
+template <std::size_t I>
+const SeqList<typename SoASeqList<Fields...>::template field_type<I>>&
+SoASeqList<Fields...>::columnList() const noexcept {
+    return std::get<I>(columns_);
+}
+
+template <typename... Fields>
+template <std::size_t I>
+typename SoASeqList<Fields...>::size_type
+SoASeqList<Fields...>::find(const field_type<I>& value) const noexcept {
+    return std::get<I>(columns_).find(value);
+}
+
+template <typename... Fields>
+void SoASeqList<Fields...>::ensureCapacity() {
+    size_type n = size();
+    bool full = std::apply([n](const SeqList<Fields>&... columns) {
+        return ((columns.capacity() <= n) || ...);
+    }, columns_);
+    if (full) {
+        reserve(n < 4 ? 4 : n * 2);
+    }
+}
+
+template <typename... Fields>
+template <std::size_t... Is>
+void SoASeqList<Fields...>::pushBackRow(std::index_sequence<Is...>, Fields&... values) {
+    (std::get<Is>(columns_).pushBack(std::move(values)), ...);
+}
+
+template <typename... Fields>
+template <std::size_t... Is>
+void SoASeqList<Fields...>::insertRow(size_type pos, std::index_sequence<Is...>,
+                                      Fields&... values) {
+    (std::get<Is>(columns_).insert(pos, std::move(values)), ...);
+}
+
+template <typename... Fields>
+template <std::size_t... Is>
+typename SoASeqList<Fields...>::value_type
+SoASeqList<Fields...>::load(size_type pos, std::index_sequence<Is...>) const {
+    return value_type(std::get<Is>(columns_)[pos]...);
+}
+
+template <typename... Fields>
+template <std::size_t... Is>
+void SoASeqList<Fields...>::store(size_type pos, const value_type& row,
+                                  std::index_sequence<Is...>) {
+    ((std::get<Is>(columns_)[pos] = std::get<Is>(row)), ...);
+}
+
+}
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "seq_list.hpp"
+
+namespace ds {
+
+// TieredSeqList: a sequential list with the index-based API of SeqList,
+// stored as a tiered vector.
+//
+// Elements live in blocks of B slots, each block a circular buffer. Every
+// block but the last is full, so element i is slot (i mod B) of block i / B:
+// O(1) random access. Inserting or erasing shifts at most half a block and
+// then passes one element across each following block boundary, which is
+// O(1) per block thanks to the circular layout. B is kept near sqrt(n), so
+// insert and erase anywhere are O(sqrt(n)).
+template <typename T>
+class TieredSeqList {
+public:
+    using size_type = std::size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    TieredSeqList();
+    ~TieredSeqList();
+
+    TieredSeqList(const TieredSeqList& other);
+    TieredSeqList& operator=(TieredSeqList other) noexcept;
+    TieredSeqList(TieredSeqList&& other) noexcept;
+
+    template<class U>
+    void pushBack(U&& value);
+
+    template<class U>
+    void pushFront(U&& value);
+
+    void popBack();
+    void popFront();
+
+    template<class U>
+    bool insert(size_type pos, U&& value);
+
+    bool erase(size_type pos);
+
+    size_type find(const T& value) const noexcept;
+
+    void set(size_type pos, const T& value);
+
+    void clear() noexcept;
+
+    size_type size() const;
+    bool empty() const;
+
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+private:
+    // A circular buffer of (1 << shift_) slots
+    struct Block {
+        T* slots;
+        size_type head;     // slot of the block's first element
+        size_type count;
+    };
+
+    explicit TieredSeqList(size_type shift);
+
+    size_type blockSize() const noexcept;
+    size_type mask() const noexcept;
+    T* slot(const Block& block, size_type offset) const noexcept;
+
+    Block& appendBlock();
+    void releaseBlock(Block& block) noexcept;
+
+    template<class U>
+    void insertAt(size_type pos, U&& value);
+    void removeAt(size_type pos) noexcept;
+
+    // Moves the element at `from` into the raw slot `to`
+    static void relocate(T* from, T* to) noexcept;
+
+    void grow();
+    void shrink();
+    void rebuild(size_type newShift);
+    void swap(TieredSeqList& other) noexcept;
+
+private:
+    SeqList<Block> blocks_;
+    size_type size_ = 0;
+    size_type shift_ = kMinShift;   // log2 of the block size
+
+    static constexpr size_type kMinShift = 4;
+};
+
+template <typename T>
+TieredSeqList<T>::TieredSeqList()
+    : size_(0), shift_(kMinShift) {}
+
+template <typename T>
+TieredSeqList<T>::TieredSeqList(size_type shift)
+    : size_(0), shift_(shift) {}
+
+template <typename T>
+TieredSeqList<T>::~TieredSeqList() {
+    clear();
+}
+
+// The blocks are raw storage, so a throwing copy frees what it built itself
+template <typename T>
+TieredSeqList<T>::TieredSeqList(const TieredSeqList& other)
+    : size_(0), shift_(other.shift_) {
+    try {
+        for (size_type i = 0; i < other.size_; ++i) {
+            pushBack(other[i]);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T>
+TieredSeqList<T>& TieredSeqList<T>::operator=(TieredSeqList other) noexcept {
+    swap(other);
+    return *this;
+}
+
+template <typename T>
+TieredSeqList<T>::TieredSeqList(TieredSeqList&& other) noexcept
+    : blocks_(std::move(other.blocks_)), size_(other.size_), shift_(other.shift_) {
+    other.size_ = 0;
+    other.shift_ = kMinShift;
+}
+
+template <typename T>
+template <class U>
+void TieredSeqList<T>::pushBack(U&& value) {
+    insertAt(size_, std::forward<U>(value));
+}
+
+template <typename T>
+template <class U>
+void TieredSeqList<T>::pushFront(U&& value) {
+    insertAt(0, std::forward<U>(value));
+}
+
+template <typename T>
+void TieredSeqList<T>::popBack() {
+    assert(size_ > 0 && "Cannot pop from an empty list.");
+    removeAt(size_ - 1);
+}
+
+template <typename T>
+void TieredSeqList<T>::popFront() {
+    assert(size_ > 0 && "Cannot pop from an empty list.");
+    removeAt(0);
+}
+
+template <typename T>
+template <class U>
+bool TieredSeqList<T>::insert(size_type pos, U&& value) {
+    if (pos > size_) {
+        return false;
+    }
+    insertAt(pos, std::forward<U>(value));
+    return true;
+}
+
+template <typename T>
+bool TieredSeqList<T>::erase(size_type pos) {
+    if (pos >= size_) {
+        return false;
+    }
+    removeAt(pos);
+    return true;
+}
+
+// Each block is at most two contiguous runs of slots, scanned like a SeqList
+template <typename T>
+typename TieredSeqList<T>::size_type TieredSeqList<T>::find(const T& value) const noexcept {
+    for (size_type b = 0; b < blocks_.size(); ++b) {
+        const Block& block = blocks_[b];
+        size_type firstRun = blockSize() - block.head;
+        if (firstRun > block.count) {
+            firstRun = block.count;
+        }
+
+        detail::simd::FirstMatch sink;
+        detail::simd::scan(block.slots + block.head, firstRun, detail::simd::EqualTo<T>{value}, sink);
+        if (sink.pos != npos) {
+            return (b << shift_) + sink.pos;
+        }
+        detail::simd::scan(block.slots, block.count - firstRun, detail::simd::EqualTo<T>{value}, sink);
+        if (sink.pos != npos) {
+            return (b << shift_) + firstRun + sink.pos;
+        }
+    }
+    return npos;
+}
+
+template <typename T>
+void TieredSeqList<T>::set(size_type pos, const T& value) {
+    assert(pos < size_);
+    (*this)[pos] = value;
+}
+
+template <typename T>
+void TieredSeqList<T>::clear() noexcept {
+    for (size_type b = 0; b < blocks_.size(); ++b) {
+        releaseBlock(blocks_[b]);
+    }
+    blocks_.clear();
+    size_ = 0;
+}
+
+template <typename T>
+typename TieredSeqList<T>::size_type TieredSeqList<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+bool TieredSeqList<T>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T>
+T& TieredSeqList<T>::operator[](size_type pos) {
+    assert(pos < size_);
+    return *slot(blocks_[pos >> shift_], pos & mask());
+}
+
+template <typename T>
+const T& TieredSeqList<T>::operator[](size_type pos) const {
+    assert(pos < size_);
+    return *slot(blocks_[pos >> shift_], pos & mask());
+}
+
+template <typename T>
+typename TieredSeqList<T>::size_type TieredSeqList<T>::blockSize() const noexcept {
+    return size_type{1} << shift_;
+}
+
+template <typename T>
+typename TieredSeqList<T>::size_type TieredSeqList<T>::mask() const noexcept {
+    return blockSize() - 1;
+}
+
+template <typename T>
+T* TieredSeqList<T>::slot(const Block& block, size_type offset) const noexcept {
+    return block.slots + ((block.head + offset) & mask());
+}
+
+template <typename T>
+typename TieredSeqList<T>::Block& TieredSeqList<T>::appendBlock() {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "TieredSeqList does not support over-aligned element types");
+
+    void* p = std::malloc(blockSize() * sizeof(T));
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    try {
+        blocks_.pushBack(Block{static_cast<T*>(p), 0, 0});
+    } catch (...) {
+        std::free(p);
+        throw;
+    }
+    return blocks_[blocks_.size() - 1];
+}
+
+template <typename T>
+void TieredSeqList<T>::releaseBlock(Block& block) noexcept {
+    for (size_type i = 0; i < block.count; ++i) {
+        std::destroy_at(slot(block, i));
+    }
+    std::free(block.slots);
+    block.slots = nullptr;
+    block.count = 0;
+}
+
+template <typename T>
+template <class U>
+void TieredSeqList<T>::insertAt(size_type pos, U&& value) {
+    assert(pos <= size_);
+
+    // Materialize first: value may refer to an element that moves below
+    T tmp(std::forward<U>(value));
+
+    if (size_ == (blocks_.size() << shift_)) {
+        appendBlock();
+    }
+
+    // Make room in the target block by passing one element down each
+    // boundary, from the last block back to it
+    size_type target = pos >> shift_;
+    for (size_type b = blocks_.size() - 1; b > target; --b) {
+        Block& from = blocks_[b - 1];
+        Block& to = blocks_[b];
+        to.head = (to.head - 1) & mask();
+        relocate(slot(from, from.count - 1), slot(to, 0));
+        --from.count;
+        ++to.count;
+    }
+
+    // Open a slot at the offset, shifting whichever side is shorter
+    Block& block = blocks_[target];
+    size_type offset = pos & mask();
+    if (offset < block.count - offset) {
+        block.head = (block.head - 1) & mask();
+        for (size_type i = 0; i < offset; ++i) {
+            relocate(slot(block, i + 1), slot(block, i));
+        }
+    } else {
+        for (size_type i = block.count; i > offset; --i) {
+            relocate(slot(block, i - 1), slot(block, i));
+        }
+    }
+    ::new (static_cast<void*>(slot(block, offset))) T(std::move(tmp));
+    ++block.count;
+    ++size_;
+
+    // The element is in, so growing is best effort like shrinking: a failed
+    // rebuild leaves the list as it was and the next insert tries again
+    try {
+        grow();
+    } catch (...) {
+    }
+}
+
+template <typename T>
+void TieredSeqList<T>::removeAt(size_type pos) noexcept {
+    assert(pos < size_);
+
+    // Close the gap inside the target block, shifting the shorter side
+    size_type target = pos >> shift_;
+    Block& block = blocks_[target];
+    size_type offset = pos & mask();
+    std::destroy_at(slot(block, offset));
+    if (offset < block.count - 1 - offset) {
+        for (size_type i = offset; i > 0; --i) {
+            relocate(slot(block, i - 1), slot(block, i));
+        }
+        block.head = (block.head + 1) & mask();
+    } else {
+        for (size_type i = offset + 1; i < block.count; ++i) {
+            relocate(slot(block, i), slot(block, i - 1));
+        }
+    }
+    --block.count;
+
+    // Refill it by pulling one element up each following boundary
+    for (size_type b = target + 1; b < blocks_.size(); ++b) {
+        Block& to = blocks_[b - 1];
+        Block& from = blocks_[b];
+        relocate(slot(from, 0), slot(to, to.count));
+        from.head = (from.head + 1) & mask();
+        --from.count;
+        ++to.count;
+    }
+
+    Block& last = blocks_[blocks_.size() - 1];
+    if (last.count == 0) {
+        releaseBlock(last);
+        blocks_.popBack();
+    }
+    --size_;
+
+    // Shrinking is best effort: a failed rebuild leaves the list as it was
+    try {
+        shrink();
+    } catch (...) {
+    }
+}
+
+template <typename T>
+void TieredSeqList<T>::relocate(T* from, T* to) noexcept {
+    ::new (static_cast<void*>(to)) T(std::move(*from));
+    std::destroy_at(from);
+}
+
+// The block size is kept within a factor of two of sqrt(size): blocks
+// double once there are more than 2B of them and halve once there are fewer
+// than B/8. Each rebuild is O(n) and leaves O(n) operations before the next.
+template <typename T>
+void TieredSeqList<T>::grow() {
+    if (blocks_.size() > 2 * blockSize()) {
+        rebuild(shift_ + 1);
+    }
+}
+
+template <typename T>
+void TieredSeqList<T>::shrink() {
+    if (shift_ > kMinShift && blocks_.size() < blockSize() / 8) {
+        rebuild(shift_ - 1);
+    }
+}
+
+// All new blocks are allocated before the first element moves, so a
+// failure leaves the list untouched
+template <typename T>
+void TieredSeqList<T>::rebuild(size_type newShift) {
+    TieredSeqList rebuilt(newShift);
+    size_type blocks = (size_ + rebuilt.mask()) >> newShift;
+    rebuilt.blocks_.reserve(blocks);
+    for (size_type b = 0; b < blocks; ++b) {
+        rebuilt.appendBlock();
+    }
+
+    size_type pos = 0;
+    for (size_type b = 0; b < blocks_.size(); ++b) {
+        Block& from = blocks_[b];
+        for (size_type i = 0; i < from.count; ++i, ++pos) {
+            Block& to = rebuilt.blocks_[pos >> newShift];
+            relocate(slot(from, i), rebuilt.slot(to, to.count));
+            ++to.count;
+        }
+        from.count = 0;
+    }
+    rebuilt.size_ = pos;
+
+    swap(rebuilt);
+}
+
+template <typename T>
+void TieredSeqList<T>::swap(TieredSeqList& other) noexcept {
+    using std::swap;
+    SeqList<Block> blocks(std::move(blocks_));
+    blocks_ = std::move(other.blocks_);
+    other.blocks_ = std::move(blocks);
+    swap(size_, other.size_);
+    swap(shift_, other.shift_);
+}
+
+}
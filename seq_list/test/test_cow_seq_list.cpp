@@ -0,0 +1,173 @@
+// test_cow_seq_list.cpp
+// Catch2 unit tests for template class CowSeqList<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "cow_seq_list.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ds::CowSeqList;
+
+namespace {
+
+// Counts copies, so that a deep copy cannot go unnoticed
+struct Counted {
+    static int copies;
+    int value;
+
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& other) : value(other.value) { ++copies; }
+    Counted(Counted&&) noexcept = default;
+    Counted& operator=(const Counted& other) { value = other.value; ++copies; return *this; }
+    Counted& operator=(Counted&&) noexcept = default;
+
+    bool operator==(const Counted& other) const { return value == other.value; }
+};
+
+int Counted::copies = 0;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// SeqList behaviour
+// -----------------------------------------------------------------------------
+TEST_CASE("CowSeqList supports the SeqList editing operations", "[push][insert][erase]") {
+    CowSeqList<int> list;
+    REQUIRE(list.empty());
+
+    list.pushBack(2);
+    list.pushFront(1);
+    REQUIRE(list.insert(2, 3));         // {1, 2, 3}
+    REQUIRE_FALSE(list.insert(9, 0));
+    list.set(0, 10);                    // {10, 2, 3}
+    REQUIRE(list.erase(1));             // {10, 3}
+    REQUIRE_FALSE(list.erase(5));
+
+    REQUIRE(list.size() == 2);
+    REQUIRE(list[0] == 10);
+    REQUIRE(list[1] == 3);
+    REQUIRE(list.find(3) == 1);
+    REQUIRE(list.count(7) == 0);
+
+    list.popFront();
+    list.popBack();
+    REQUIRE(list.empty());
+}
+
+// -----------------------------------------------------------------------------
+// Sharing and copy-on-write
+// -----------------------------------------------------------------------------
+TEST_CASE("snapshot and copies share the buffer until a write", "[snapshot][cow]") {
+    CowSeqList<Counted> list;
+    for (int i = 0; i < 100; ++i) {
+        list.pushBack(Counted(i));
+    }
+    Counted::copies = 0;
+
+    auto snap = list.snapshot();
+    CowSeqList<Counted> copy = list;
+    REQUIRE(list.shared());
+    REQUIRE(snap.data() == list.data());
+    REQUIRE(copy.data() == list.data());
+    REQUIRE(Counted::copies == 0);
+
+    SECTION("a write copies the shared buffer once") {
+        list.set(0, Counted(-1));
+        REQUIRE(Counted::copies == 100 + 1);
+        REQUIRE(list[0].value == -1);
+        REQUIRE(snap[0].value == 0);        // Snapshot keeps the old contents
+        REQUIRE(copy[0].value == 0);
+        REQUIRE(snap.data() == copy.data());
+
+        // The writer's buffer is its own now: later writes copy nothing
+        Counted::copies = 0;
+        list.pushBack(Counted(100));
+        list.erase(5);
+        REQUIRE(Counted::copies == 0);
+        REQUIRE_FALSE(list.shared());
+    }
+
+    SECTION("dropping the other references makes writes in-place again") {
+        snap = decltype(snap)();
+        copy = CowSeqList<Counted>();
+        REQUIRE_FALSE(list.shared());
+        const Counted* before = list.data();
+        list.set(1, Counted(-2));
+        REQUIRE(list.data() == before);
+        REQUIRE(Counted::copies == 1);      // Only the assigned element
+    }
+
+    SECTION("clear on a shared list does not copy") {
+        list.clear();
+        REQUIRE(list.empty());
+        REQUIRE(snap.size() == 100);
+        REQUIRE(Counted::copies == 0);
+    }
+}
+
+TEST_CASE("writes may take their value from the shared buffer", "[cow][alias]") {
+    CowSeqList<std::string> list;
+    list.pushBack(std::string(40, 'a'));
+    {
+        auto snap = list.snapshot();
+        list.pushBack(list[0]);             // list[0] lives in the shared buffer
+    }
+    REQUIRE(list.size() == 2);
+    REQUIRE(list[1] == std::string(40, 'a'));
+}
+
+TEST_CASE("a list restored from a snapshot shares it", "[snapshot]") {
+    CowSeqList<int> list;
+    list.pushBack(1);
+    auto snap = list.snapshot();
+    list.pushBack(2);
+
+    CowSeqList<int> restored(snap);
+    REQUIRE(restored.size() == 1);
+    REQUIRE(restored.data() == snap.data());
+
+    CowSeqList<int> moved = std::move(list);
+    REQUIRE(moved.size() == 2);
+    REQUIRE(list.empty());                  // Moved-from list is empty but usable
+    list.pushBack(3);
+    REQUIRE(list[0] == 3);
+    REQUIRE(CowSeqList<int>::Snapshot().empty());
+}
+
+// -----------------------------------------------------------------------------
+// Concurrent readers
+// -----------------------------------------------------------------------------
+TEST_CASE("readers keep consistent snapshots while the writer edits", "[snapshot][thread]") {
+    CowSeqList<int> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.pushBack(0);
+    }
+
+    // Each reader owns a snapshot of one version, in which every element
+    // holds that version's number, and rereads it while the writer moves on
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int round = 1; round <= 50; ++round) {
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            list.set(i, round);
+        }
+        readers.emplace_back([snap = list.snapshot(), round, &torn] {
+            for (int pass = 0; pass < 20; ++pass) {
+                for (std::size_t i = 0; i < snap.size(); ++i) {
+                    if (snap[i] != round) {
+                        torn.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& t : readers) {
+        t.join();
+    }
+    REQUIRE(torn.load() == 0);
+    REQUIRE_FALSE(list.shared());
+}
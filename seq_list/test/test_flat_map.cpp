@@ -0,0 +1,176 @@
+// test_flat_map.cpp
+// Catch2 unit tests for template class FlatMap<K, V>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "flat_map.hpp"
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ds::FlatMap;
+
+namespace {
+
+template <typename K, typename V>
+bool sameAs(const FlatMap<K, V>& map, const std::map<K, V>& expected) {
+    if (map.size() != expected.size()) {
+        return false;
+    }
+    std::size_t i = 0;
+    for (const auto& entry : expected) {
+        if (map.keyAt(i) != entry.first || map.valueAt(i) != entry.second) {
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// The AVLTree lookup API
+// -----------------------------------------------------------------------------
+TEST_CASE("FlatMap default-constructed map is empty", "[constructor]") {
+    FlatMap<int, std::string> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.find(1) == nullptr);
+    REQUIRE_FALSE(map.contains(1));
+}
+
+TEST_CASE("FlatMap insert, find, contains and erase", "[insert][find][erase]") {
+    FlatMap<int, std::string> map;
+    map.insert(20, "twenty");
+    map.insert(10, "ten");
+    map.insert(30, "thirty");
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.contains(10));
+    REQUIRE_FALSE(map.contains(15));
+    REQUIRE(*map.find(20) == "twenty");
+    REQUIRE(map.find(25) == nullptr);
+
+    SECTION("insert updates an existing key") {
+        map.insert(20, "TWENTY");
+        REQUIRE(map.size() == 3);
+        REQUIRE(*map.find(20) == "TWENTY");
+    }
+
+    SECTION("find returns a mutable value") {
+        *map.find(10) = "TEN";
+        const FlatMap<int, std::string>& view = map;
+        REQUIRE(*view.find(10) == "TEN");
+    }
+
+    SECTION("erase removes only present keys") {
+        REQUIRE(map.erase(10));
+        REQUIRE_FALSE(map.erase(10));
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.keyAt(0) == 20);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Bulk build and batched insertion
+// -----------------------------------------------------------------------------
+TEST_CASE("FlatMap bulk build sorts and keeps the last of repeated keys", "[bulk]") {
+    FlatMap<int, int> map{{5, 1}, {1, 1}, {5, 2}, {3, 1}, {1, 2}, {5, 3}};
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.keyAt(0) == 1);
+    REQUIRE(map.keyAt(1) == 3);
+    REQUIRE(map.keyAt(2) == 5);
+    REQUIRE(*map.find(1) == 2);
+    REQUIRE(*map.find(5) == 3);
+}
+
+TEST_CASE("FlatMap insertBatch merges new keys and updates existing ones", "[batch]") {
+    FlatMap<int, int> map{{2, 0}, {4, 0}, {6, 0}};
+    std::vector<std::pair<int, int>> batch{{5, 1}, {4, 1}, {1, 1}, {7, 1}, {5, 2}};
+    map.insertBatch(batch.begin(), batch.end());
+
+    std::map<int, int> expected{{1, 1}, {2, 0}, {4, 1}, {5, 2}, {6, 0}, {7, 1}};
+    REQUIRE(sameAs(map, expected));
+
+    map.insertBatch(batch.begin(), batch.begin());     // empty batch
+    REQUIRE(sameAs(map, expected));
+}
+
+TEST_CASE("FlatMap insertBatch keeps heap-allocated strings intact", "[batch]") {
+    const std::string a(40, 'a');       // Too long for the small-string buffer
+    const std::string b(40, 'b');
+    const std::string c(40, 'c');
+
+    FlatMap<std::string, std::string> map;
+    std::vector<std::pair<std::string, std::string>> batch{{b, a + "1"}, {a, b + "1"}};
+    map.insertBatch(batch.begin(), batch.end());
+    REQUIRE(map.contains(a));
+    REQUIRE(*map.find(a) == b + "1");
+    REQUIRE(*map.find(b) == a + "1");
+
+    batch = {{c, c}, {a, a}};           // One new key, one existing
+    map.insertBatch(batch.begin(), batch.end());
+    REQUIRE(map.size() == 3);
+    REQUIRE(*map.find(a) == a);
+    REQUIRE(*map.find(c) == c);
+}
+
+TEST_CASE("FlatMap matches std::map under random operations", "[random]") {
+    std::mt19937 rng(5);
+    FlatMap<int, int> map;
+    std::map<int, int> expected;
+
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::pair<int, int>> batch;
+        for (int i = 0; i < 200; ++i) {
+            int key = static_cast<int>(rng() % 2000);
+            int value = static_cast<int>(rng());
+            switch (rng() % 3) {
+            case 0:
+                map.insert(key, value);
+                expected[key] = value;
+                break;
+            case 1:
+                REQUIRE(map.erase(key) == (expected.erase(key) == 1));
+                break;
+            default:
+                batch.emplace_back(key, value);
+                break;
+            }
+        }
+        map.insertBatch(batch.begin(), batch.end());
+        for (const auto& entry : batch) {
+            expected[entry.first] = entry.second;
+        }
+        REQUIRE(sameAs(map, expected));
+    }
+
+    for (int key = -1; key <= 2000; ++key) {
+        auto it = expected.find(key);
+        const int* value = map.find(key);
+        REQUIRE((value != nullptr) == (it != expected.end()));
+        if (value != nullptr) {
+            REQUIRE(*value == it->second);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Copy and move
+// -----------------------------------------------------------------------------
+TEST_CASE("FlatMap copies are deep and moves transfer the entries", "[copy][move]") {
+    FlatMap<std::string, int> a{{"b", 2}, {"a", 1}};
+    FlatMap<std::string, int> b = a;
+    b.insert(std::string("c"), 3);
+    REQUIRE(a.size() == 2);
+    REQUIRE(b.size() == 3);
+
+    FlatMap<std::string, int> c = std::move(b);
+    REQUIRE(c.size() == 3);
+    REQUIRE(*c.find("c") == 3);
+}
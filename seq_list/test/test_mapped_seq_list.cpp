@@ -0,0 +1,148 @@
+// test_mapped_seq_list.cpp
+// Catch2 unit tests for template class MappedSeqList<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "mapped_seq_list.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+using ds::MappedSeqList;
+
+namespace {
+
+// A file path in the temp directory that is removed again on scope exit
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / name).string()) {
+        std::filesystem::remove(path);
+    }
+    ~TempFile() { std::filesystem::remove(path); }
+};
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+
+    bool operator==(const Point& other) const { return x == other.x && y == other.y; }
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Creation and basic state
+// -----------------------------------------------------------------------------
+TEST_CASE("A new MappedSeqList file starts empty", "[constructor]") {
+    TempFile file("ds_mapped_new.bin");
+    MappedSeqList<int> list(file.path);
+
+    REQUIRE(list.empty());
+    REQUIRE(list.size() == 0);
+    REQUIRE(list.capacity() > 0);
+    REQUIRE(std::filesystem::exists(file.path));
+}
+
+// -----------------------------------------------------------------------------
+// Persistence across reopen
+// -----------------------------------------------------------------------------
+TEST_CASE("Elements persist after the list is reopened", "[persist]") {
+    TempFile file("ds_mapped_persist.bin");
+    {
+        MappedSeqList<Point> list(file.path);
+        list.pushBack(Point{1, 2});
+        list.pushBack(Point{3, 4});
+        list.flush();
+    }
+
+    MappedSeqList<Point> reopened(file.path);
+    REQUIRE(reopened.size() == 2);
+    REQUIRE(reopened[0] == Point{1, 2});
+    REQUIRE(reopened[1] == Point{3, 4});
+}
+
+// -----------------------------------------------------------------------------
+// Growth through ftruncate + mremap
+// -----------------------------------------------------------------------------
+TEST_CASE("Growth keeps elements and the file tracks capacity", "[growth]") {
+    TempFile file("ds_mapped_growth.bin");
+    {
+        MappedSeqList<std::uint64_t> list(file.path);
+        for (std::uint64_t i = 0; i < 100000; ++i) {
+            list.pushBack(i * 3);
+        }
+        list.pushBack(list[0]);     // Reference into the mapping
+
+        REQUIRE(list.size() == 100001);
+        REQUIRE(list.capacity() >= 100001);
+        REQUIRE(list[99999] == 99999 * 3);
+        REQUIRE(list[100000] == 0);
+    }
+
+    MappedSeqList<std::uint64_t> reopened(file.path);
+    REQUIRE(reopened.size() == 100001);
+    REQUIRE(reopened.find(300) == 100);
+    REQUIRE(reopened.find(1) == MappedSeqList<std::uint64_t>::npos);
+    REQUIRE(reopened.count(0) == 2);
+}
+
+// -----------------------------------------------------------------------------
+// insert / erase / set / popBack
+// -----------------------------------------------------------------------------
+TEST_CASE("Editing operations match the in-memory list", "[insert][erase][set]") {
+    TempFile file("ds_mapped_edit.bin");
+    MappedSeqList<int> list(file.path);
+    list.pushBack(1);
+    list.pushBack(3);
+
+    REQUIRE(list.insert(1, 2));     // {1, 2, 3}
+    REQUIRE_FALSE(list.insert(9, 0));
+    REQUIRE(list[1] == 2);
+
+    list.set(0, 10);                // {10, 2, 3}
+    REQUIRE(list.erase(1));         // {10, 3}
+    REQUIRE_FALSE(list.erase(2));
+    REQUIRE(list.size() == 2);
+    REQUIRE(list[1] == 3);
+
+    list.popBack();
+    REQUIRE(list.size() == 1);
+    list.clear();
+    REQUIRE(list.empty());
+}
+
+// -----------------------------------------------------------------------------
+// Invalid files
+// -----------------------------------------------------------------------------
+TEST_CASE("Opening with a different element type is rejected", "[error]") {
+    TempFile file("ds_mapped_mismatch.bin");
+    {
+        MappedSeqList<std::int32_t> list(file.path);
+        list.pushBack(7);
+    }
+    REQUIRE_THROWS_AS(MappedSeqList<std::uint64_t>(file.path), std::runtime_error);
+}
+
+// -----------------------------------------------------------------------------
+// Move constructor and assignment
+// -----------------------------------------------------------------------------
+TEST_CASE("MappedSeqList moves transfer the mapping", "[move]") {
+    TempFile first("ds_mapped_move_a.bin");
+    TempFile second("ds_mapped_move_b.bin");
+
+    MappedSeqList<int> a(first.path);
+    a.pushBack(5);
+
+    MappedSeqList<int> moved = std::move(a);
+    REQUIRE(moved.size() == 1);
+    REQUIRE(moved[0] == 5);
+
+    MappedSeqList<int> b(second.path);
+    b = std::move(moved);
+    REQUIRE(b.size() == 1);
+    REQUIRE(b[0] == 5);
+}
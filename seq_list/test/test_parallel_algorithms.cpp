@@ -0,0 +1,142 @@
+// test_parallel_algorithms.cpp
+// Catch2 unit tests for the parallel algorithms over SeqList<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "parallel_algorithms.hpp"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using ds::SeqList;
+namespace par = ds::parallel;
+
+namespace {
+
+// Large enough to be cut into several chunks
+constexpr std::size_t kLarge = 5 * par::kSerialCutoff + 123;
+
+SeqList<int> randomList(std::size_t n, int range) {
+    std::mt19937 rng(7);
+    SeqList<int> list;
+    list.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        list.pushBack(static_cast<int>(rng() % range));
+    }
+    return list;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// ThreadPool
+// -----------------------------------------------------------------------------
+TEST_CASE("ThreadPool runs every task exactly once", "[pool]") {
+    par::ThreadPool pool(3);
+    REQUIRE(pool.concurrency() == 4);
+
+    std::vector<std::atomic<int>> hits(1000);
+    for (int round = 0; round < 20; ++round) {
+        pool.run(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+    }
+    for (auto& h : hits) {
+        REQUIRE(h.load() == 20);
+    }
+}
+
+TEST_CASE("ThreadPool rethrows task exceptions and runs nested batches serially", "[pool]") {
+    par::ThreadPool pool(2);
+
+    REQUIRE_THROWS_AS(pool.run(16, [](std::size_t i) {
+        if (i == 5) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+
+    std::atomic<int> inner{0};
+    pool.run(4, [&](std::size_t) {
+        pool.run(4, [&](std::size_t) { inner.fetch_add(1); });
+    });
+    REQUIRE(inner.load() == 16);
+}
+
+// -----------------------------------------------------------------------------
+// sort / stableSort
+// -----------------------------------------------------------------------------
+TEST_CASE("parallel sort matches std::sort", "[sort]") {
+    par::ThreadPool pool(3);
+    for (std::size_t n : {std::size_t{0}, std::size_t{10}, kLarge}) {
+        SeqList<int> list = randomList(n, 1000000);
+        std::vector<int> expected(list.data(), list.data() + list.size());
+        std::sort(expected.begin(), expected.end());
+
+        par::sort(list, std::less<>(), pool);
+        REQUIRE(std::equal(expected.begin(), expected.end(), list.data()));
+    }
+
+    SeqList<int> descending = randomList(kLarge, 100);
+    par::sort(descending, std::greater<>(), pool);
+    REQUIRE(std::is_sorted(descending.data(), descending.data() + descending.size(),
+                           std::greater<>()));
+}
+
+TEST_CASE("parallel stableSort keeps the order of equal keys", "[sort][stable]") {
+    par::ThreadPool pool(3);
+    SeqList<std::pair<int, std::size_t>> list;
+    SeqList<int> keys = randomList(kLarge, 50);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        list.pushBack(std::make_pair(keys[i], i));   // second = original position
+    }
+
+    par::stableSort(list, [](const auto& a, const auto& b) { return a.first < b.first; }, pool);
+
+    for (std::size_t i = 1; i < list.size(); ++i) {
+        REQUIRE((list[i - 1].first < list[i].first ||
+                 (list[i - 1].first == list[i].first && list[i - 1].second < list[i].second)));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// transform / forEach / reduce / countIf
+// -----------------------------------------------------------------------------
+TEST_CASE("parallel transform, forEach, reduce and countIf", "[transform][reduce]") {
+    par::ThreadPool pool(3);
+    SeqList<int> list = randomList(kLarge, 100);
+
+    long long sum = 0;
+    std::size_t small = 0;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        sum += list[i];
+        small += list[i] < 10 ? 1 : 0;
+    }
+
+    REQUIRE(par::countIf(list, [](int x) { return x < 10; }, pool) == small);
+
+    SeqList<long long> wide;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        wide.pushBack(list[i]);
+    }
+    REQUIRE(par::reduce(wide, 1000LL, std::plus<>(), pool) == sum + 1000);
+
+    par::transform(list, [](int x) { return x * 2; }, pool);
+    REQUIRE(par::countIf(list, [](int x) { return x % 2 != 0; }, pool) == 0);
+
+    par::forEach(list, [](int& x) { x = -x; }, pool);
+    REQUIRE(par::reduce(list, 0, std::plus<>(), pool) == -2 * static_cast<int>(sum));
+}
+
+TEST_CASE("reduce combines chunks in order", "[reduce]") {
+    par::ThreadPool pool(3);
+    SeqList<std::string> list;
+    std::string expected;
+    for (std::size_t i = 0; i < kLarge; ++i) {
+        char c = static_cast<char>('a' + i % 26);
+        list.pushBack(std::string(1, c));
+        expected += c;
+    }
+    // String concatenation is associative but not commutative
+    REQUIRE(par::reduce(list, std::string(">"), std::plus<>(), pool) == ">" + expected);
+}
@@ -5,9 +5,15 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "seq_list.hpp"            // The container under test
+#include <cstdint>
+#include <sstream>
+#include <iterator>
+#include <random>
 #include <string>
+#include <vector>
 
 using ds::SeqList;                          // Short-hand for the qualified name
+using ds::SmallSeqList;
 
 // -----------------------------------------------------------------------------
 // Basic construction and state inspection
@@ -148,4 +154,484 @@ TEST_CASE("SeqList supports move assignment", "[move][assignment]") {
 
     REQUIRE(list1.empty());         // Moved-from list is now empty
     REQUIRE(list1.size() == 0);
-}
\ No newline at end of file
+}
+
+// -----------------------------------------------------------------------------
+// Growth and element lifetime
+// -----------------------------------------------------------------------------
+namespace {
+
+// Counts live instances so tests can check that every constructed element is
+// destroyed exactly once. Deliberately has no default constructor.
+struct Tracked {
+    static int live;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { --live; }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
+int Tracked::live = 0;
+
+} // namespace
+
+TEST_CASE("Growth relocates elements and keeps their values", "[growth]") {
+    SeqList<std::string> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.pushBack(std::string(32, 'a') + std::to_string(i));
+    }
+
+    REQUIRE(list.size() == 1000);
+    REQUIRE(list[0] == std::string(32, 'a') + "0");
+    REQUIRE(list[999] == std::string(32, 'a') + "999");
+}
+
+TEST_CASE("Growth of trivially copyable elements keeps their values", "[growth]") {
+    SeqList<int> list;
+    for (int i = 0; i < 10000; ++i) {
+        list.pushBack(i);
+    }
+
+    REQUIRE(list.size() == 10000);
+    for (int i = 0; i < 10000; ++i) {
+        REQUIRE(list[i] == i);
+    }
+}
+
+TEST_CASE("Pushing an element of the list itself survives growth", "[growth][alias]") {
+    SeqList<std::string> list;
+    list.pushBack("first");
+    for (int i = 0; i < 64; ++i) {
+        list.pushBack(list[0]);     // Reference into the buffer being grown
+    }
+
+    REQUIRE(list.size() == 65);
+    REQUIRE(list[64] == "first");
+
+    list.insert(1, list[64]);       // Reference into the range being shifted
+    REQUIRE(list[1] == "first");
+}
+
+TEST_CASE("Elements are constructed on demand and destroyed exactly once",
+          "[growth][lifetime]") {
+    Tracked::live = 0;
+    {
+        SeqList<Tracked> list;                  // No default construction needed
+        REQUIRE(Tracked::live == 0);
+
+        for (int i = 0; i < 100; ++i) {
+            list.pushBack(Tracked(i));
+        }
+        REQUIRE(Tracked::live == 100);
+
+        list.popBack();
+        list.popFront();
+        list.erase(10);
+        REQUIRE(Tracked::live == 97);
+
+        SeqList<Tracked> copy = list;
+        REQUIRE(Tracked::live == 194);
+        REQUIRE(copy.find(Tracked(50)) == list.find(Tracked(50)));
+    }
+    REQUIRE(Tracked::live == 0);
+}
+
+
+// -----------------------------------------------------------------------------
+// reserve / shrinkToFit / clear
+// -----------------------------------------------------------------------------
+TEST_CASE("reserve and shrinkToFit manage capacity", "[capacity]") {
+    SeqList<std::string> list;
+    list.reserve(100);
+    REQUIRE(list.capacity() >= 100);
+    REQUIRE(list.empty());
+
+    list.pushBack("a");
+    list.pushBack("b");
+    list.shrinkToFit();
+    REQUIRE(list.capacity() == 2);
+    REQUIRE(list[1] == "b");
+
+    list.clear();
+    REQUIRE(list.empty());
+    list.shrinkToFit();
+    REQUIRE(list.capacity() == 0);
+
+    list.pushBack("c");             // Regrows from zero capacity
+    REQUIRE(list.size() == 1);
+    REQUIRE(list[0] == "c");
+}
+
+// -----------------------------------------------------------------------------
+// insertRange / eraseRange / assign
+// -----------------------------------------------------------------------------
+namespace {
+
+template <typename T, std::size_t N>
+std::vector<T> toVector(const SeqList<T, N>& list) {
+    std::vector<T> out;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        out.push_back(list[i]);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("insertRange splices a batch at any position", "[insert][range]") {
+    SeqList<std::string> list;
+    list.assign({"a", "b", "c", "d"});
+
+    SECTION("short batch in the middle, tail longer than batch") {
+        list.reserve(16);
+        std::vector<std::string> batch{"x", "y"};
+        REQUIRE(list.insertRange(1, batch.begin(), batch.end()));
+        REQUIRE(toVector(list) == std::vector<std::string>{"a", "x", "y", "b", "c", "d"});
+    }
+
+    SECTION("long batch near the end, tail shorter than batch") {
+        list.reserve(16);
+        std::vector<std::string> batch{"x", "y", "z"};
+        REQUIRE(list.insertRange(3, batch.begin(), batch.end()));
+        REQUIRE(toVector(list) == std::vector<std::string>{"a", "b", "c", "x", "y", "z", "d"});
+    }
+
+    SECTION("batch that forces growth") {
+        std::vector<std::string> batch(100, "n");
+        REQUIRE(list.insertRange(0, batch.begin(), batch.end()));
+        REQUIRE(list.size() == 104);
+        REQUIRE(list[99] == "n");
+        REQUIRE(list[100] == "a");
+        REQUIRE(list[103] == "d");
+    }
+
+    SECTION("single-pass input range") {
+        std::istringstream in("p q");
+        std::istream_iterator<std::string> first(in), last;
+        REQUIRE(list.insertRange(2, first, last));
+        REQUIRE(toVector(list) == std::vector<std::string>{"a", "b", "p", "q", "c", "d"});
+    }
+
+    SECTION("out-of-range position is rejected") {
+        std::vector<std::string> batch{"x"};
+        REQUIRE_FALSE(list.insertRange(5, batch.begin(), batch.end()));
+        REQUIRE(list.size() == 4);
+    }
+}
+
+TEST_CASE("insertRange on trivially copyable elements", "[insert][range]") {
+    SeqList<int> list;
+    int head[] = {1, 2, 7, 8};
+    int middle[] = {3, 4, 5, 6};
+    list.assign(std::begin(head), std::end(head));
+
+    REQUIRE(list.insertRange(2, std::begin(middle), std::end(middle)));  // Grows
+    REQUIRE(toVector(list) == std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8});
+
+    list.reserve(32);
+    REQUIRE(list.insertRange(0, std::begin(middle), std::begin(middle) + 2));  // In place
+    REQUIRE(toVector(list) == std::vector<int>{3, 4, 1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_CASE("eraseRange removes a batch and clamps at the end", "[erase][range]") {
+    SeqList<std::string> list;
+    list.assign({"a", "b", "c", "d", "e"});
+
+    REQUIRE(list.eraseRange(1, 2));
+    REQUIRE(toVector(list) == std::vector<std::string>{"a", "d", "e"});
+
+    REQUIRE(list.eraseRange(1, 100));
+    REQUIRE(toVector(list) == std::vector<std::string>{"a"});
+
+    REQUIRE_FALSE(list.eraseRange(2, 1));
+    REQUIRE(list.size() == 1);
+}
+
+TEST_CASE("assign replaces the contents", "[assign]") {
+    SeqList<int> list;
+    list.pushBack(9);
+
+    list.assign(3, 5);               // (count, value), not an iterator pair
+    REQUIRE(toVector(list) == std::vector<int>{5, 5, 5});
+
+    list.assign(2, list[0]);         // Value aliasing the list
+    REQUIRE(toVector(list) == std::vector<int>{5, 5});
+}
+
+
+// -----------------------------------------------------------------------------
+// count / findAll / findIf and the SIMD scan paths
+// -----------------------------------------------------------------------------
+TEST_CASE("count, findAll and findIf on a generic element type", "[find][scan]") {
+    SeqList<std::string> list;
+    list.assign({"a", "b", "a", "c"});
+
+    REQUIRE(list.count("a") == 2);
+    REQUIRE(list.count("z") == 0);
+
+    ds::Bitmap hits = list.findAll("a");
+    REQUIRE(hits.size() == 4);
+    REQUIRE(hits.count() == 2);
+    REQUIRE(hits.test(0));
+    REQUIRE_FALSE(hits.test(1));
+    REQUIRE(hits.test(2));
+
+    REQUIRE(list.findIf([](const std::string& s) { return s > "b"; }) == 3);
+    REQUIRE(list.findIf([](const std::string& s) { return s.empty(); }) == SeqList<std::string>::npos);
+}
+
+namespace {
+
+// Checks every scan against a plain loop, over lengths that exercise the
+// vector blocks and the scalar tail.
+template <typename T>
+void checkScansAgainstScalar(T needle, T lo, T hi, T (*make)(std::mt19937_64&)) {
+    std::mt19937_64 rng(42);
+    for (std::size_t n : {0u, 1u, 3u, 15u, 16u, 17u, 63u, 64u, 65u, 1000u}) {
+        SeqList<T> list;
+        for (std::size_t i = 0; i < n; ++i) {
+            list.pushBack(make(rng));
+        }
+
+        std::size_t first = SeqList<T>::npos, count = 0, firstInRange = SeqList<T>::npos;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (list[i] == needle) {
+                if (first == SeqList<T>::npos) first = i;
+                ++count;
+            }
+            if (firstInRange == SeqList<T>::npos && lo <= list[i] && list[i] <= hi) {
+                firstInRange = i;
+            }
+        }
+
+        REQUIRE(list.find(needle) == first);
+        REQUIRE(list.count(needle) == count);
+        REQUIRE(list.findIf(ds::InRange<T>{lo, hi}) == firstInRange);
+
+        ds::Bitmap hits = list.findAll(needle);
+        REQUIRE(hits.count() == count);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(hits.test(i) == (list[i] == needle));
+        }
+
+#if DS_SIMD_X86
+        // Also cover the SSE2 path on machines where AVX2 is picked
+        ds::detail::simd::CountMatches sse2;
+        if (n > 0) {
+            ds::detail::simd::scanSse2(&list[0], n, ds::InRange<T>{lo, hi}, sse2);
+        }
+        std::size_t inRange = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            inRange += (lo <= list[i] && list[i] <= hi) ? 1 : 0;
+        }
+        REQUIRE(sse2.count == inRange);
+#endif
+    }
+}
+
+} // namespace
+
+TEST_CASE("SIMD scans match scalar results for int32_t", "[find][scan][simd]") {
+    checkScansAgainstScalar<std::int32_t>(3, -2, 1, [](std::mt19937_64& rng) {
+        return static_cast<std::int32_t>(rng() % 16) - 8;
+    });
+}
+
+TEST_CASE("SIMD scans match scalar results for uint64_t", "[find][scan][simd]") {
+    // Values straddle the sign bit to catch signed-compare mistakes
+    const std::uint64_t high = std::uint64_t{1} << 63;
+    checkScansAgainstScalar<std::uint64_t>(high + 3, high - 2, high + 1, [](std::mt19937_64& rng) {
+        return (std::uint64_t{1} << 63) + rng() % 16 - 8;
+    });
+}
+
+TEST_CASE("SIMD scans match scalar results for float", "[find][scan][simd]") {
+    checkScansAgainstScalar<float>(0.5f, -1.0f, 0.25f, [](std::mt19937_64& rng) {
+        return static_cast<float>(static_cast<int>(rng() % 16) - 8) / 4.0f;
+    });
+}
+
+
+// -----------------------------------------------------------------------------
+// SmallSeqList: inline capacity
+// -----------------------------------------------------------------------------
+namespace {
+
+// True while the elements still live inside the list object itself
+template <typename T, std::size_t N>
+bool storedInline(const SmallSeqList<T, N>& list) {
+    const auto* begin = reinterpret_cast<const unsigned char*>(&list);
+    const auto* elem = reinterpret_cast<const unsigned char*>(&list[0]);
+    return elem >= begin && elem < begin + sizeof(list);
+}
+
+} // namespace
+
+TEST_CASE("SmallSeqList keeps up to N elements inline", "[small]") {
+    SmallSeqList<std::string, 3> list;
+    REQUIRE(list.empty());
+    REQUIRE(list.capacity() == 3);
+
+    list.pushBack("a");
+    list.pushBack("b");
+    list.pushFront("z");
+    REQUIRE(storedInline(list));
+    REQUIRE(toVector(list) == std::vector<std::string>{"z", "a", "b"});
+
+    list.pushBack("c");             // Overflow moves everything to the heap
+    REQUIRE_FALSE(storedInline(list));
+    REQUIRE(list.capacity() >= 4);
+    REQUIRE(toVector(list) == std::vector<std::string>{"z", "a", "b", "c"});
+
+    list.eraseRange(0, 2);
+    list.shrinkToFit();             // Fits again: back into the inline buffer
+    REQUIRE(storedInline(list));
+    REQUIRE(list.capacity() == 3);
+    REQUIRE(toVector(list) == std::vector<std::string>{"b", "c"});
+}
+
+TEST_CASE("SmallSeqList copy, move and swap across inline and heap storage",
+          "[small][copy][move]") {
+    SmallSeqList<std::string, 2> small;
+    small.pushBack("s");
+
+    SmallSeqList<std::string, 2> large;
+    for (int i = 0; i < 5; ++i) {
+        large.pushBack(std::to_string(i));
+    }
+
+    SECTION("copies") {
+        SmallSeqList<std::string, 2> smallCopy = small;
+        SmallSeqList<std::string, 2> largeCopy = large;
+        REQUIRE(storedInline(smallCopy));
+        REQUIRE(toVector(smallCopy) == toVector(small));
+        REQUIRE(toVector(largeCopy) == toVector(large));
+    }
+
+    SECTION("move of an inline list moves the elements") {
+        SmallSeqList<std::string, 2> moved = std::move(small);
+        REQUIRE(storedInline(moved));
+        REQUIRE(toVector(moved) == std::vector<std::string>{"s"});
+        REQUIRE(small.empty());
+        small.pushBack("again");    // Moved-from list is still usable
+        REQUIRE(small[0] == "again");
+    }
+
+    SECTION("assignment swaps inline and heap contents") {
+        SmallSeqList<std::string, 2> target = large;
+        target = small;
+        REQUIRE(storedInline(target));
+        REQUIRE(toVector(target) == std::vector<std::string>{"s"});
+
+        target = std::move(large);
+        REQUIRE(target.size() == 5);
+        REQUIRE(target[4] == "4");
+        REQUIRE(large.empty());
+    }
+}
+
+TEST_CASE("SmallSeqList destroys every element it constructs", "[small][lifetime]") {
+    Tracked::live = 0;
+    {
+        SmallSeqList<Tracked, 4> a;
+        for (int i = 0; i < 3; ++i) {
+            a.pushBack(Tracked(i));
+        }
+        SmallSeqList<Tracked, 4> b;
+        for (int i = 0; i < 9; ++i) {
+            b.pushBack(Tracked(i));
+        }
+        REQUIRE(Tracked::live == 12);
+
+        a = b;                      // Heap copy replaces inline contents
+        b = SmallSeqList<Tracked, 4>();
+        REQUIRE(Tracked::live == 9);
+        REQUIRE(a.find(Tracked(8)) == 8);
+    }
+    REQUIRE(Tracked::live == 0);
+}
+
+// -----------------------------------------------------------------------------
+// Growth policies
+// -----------------------------------------------------------------------------
+TEST_CASE("Growth policies compute their capacity sequences", "[growth][policy]") {
+    using Geometric = ds::GeometricGrowth<3, 2>;
+    REQUIRE(Geometric::nextCapacity<int>(0, 1) == 4);
+    REQUIRE(Geometric::nextCapacity<int>(4, 5) == 6);
+    REQUIRE(Geometric::nextCapacity<int>(1, 2) == 2);       // Always grows
+    REQUIRE(Geometric::nextCapacity<int>(8, 100) == 100);   // Never below required
+
+    using Fixed = ds::FixedStepGrowth<16>;
+    REQUIRE(Fixed::nextCapacity<int>(0, 1) == 16);
+    REQUIRE(Fixed::nextCapacity<int>(16, 17) == 32);
+
+    using Paged = ds::PageRoundedGrowth<>;
+    REQUIRE(Paged::nextCapacity<int>(0, 1) == 1024);
+    REQUIRE(Paged::nextCapacity<double>(1024, 1025) == 2048);
+    REQUIRE(Paged::nextCapacity<char[3000]>(0, 1) == 4);    // 3 pages hold no 5th
+}
+
+TEST_CASE("SeqList grows through the chosen policy", "[growth][policy]") {
+    SECTION("fixed step") {
+        SeqList<int, 0, ds::FixedStepGrowth<10>> list;
+        REQUIRE(list.capacity() == 10);
+        for (int i = 0; i < 25; ++i) {
+            list.pushBack(i);
+        }
+        REQUIRE(list.capacity() == 30);
+        REQUIRE(list[24] == 24);
+    }
+
+    SECTION("page rounded, with non-trivial elements") {
+        SeqList<std::string, 0, ds::PageRoundedGrowth<>> list;
+        for (int i = 0; i < 500; ++i) {
+            list.pushBack(std::to_string(i));
+        }
+        REQUIRE(list.capacity() * sizeof(std::string) % 4096 == 0);
+        REQUIRE(list[499] == "499");
+    }
+}
+
+TEST_CASE("MappedGrowth keeps contents across remaps and threshold crossings",
+          "[growth][policy][mapped]") {
+    using Mapped = ds::MappedGrowth<>;
+    constexpr std::size_t kCount = (std::size_t{8} << 20) / sizeof(std::uint64_t);
+
+    SeqList<std::uint64_t, 0, Mapped> list;
+    for (std::size_t i = 0; i < kCount; ++i) {
+        list.pushBack(i * 7);           // Grows past kMapThreshold, then remaps
+    }
+    REQUIRE(list.size() == kCount);
+    REQUIRE(list.capacity() * sizeof(std::uint64_t) >= Mapped::kMapThreshold);
+    bool intact = true;
+    for (std::size_t i = 0; i < kCount; i += 4093) {
+        intact = intact && list[i] == i * 7;
+    }
+    REQUIRE(intact);
+    REQUIRE(list[kCount - 1] == (kCount - 1) * 7);
+
+    SeqList<std::uint64_t, 0, Mapped> copy = list;
+    REQUIRE(copy[kCount / 2] == list[kCount / 2]);
+
+    list.eraseRange(16, kCount - 16);
+    list.shrinkToFit();                 // Back below the threshold, onto malloc
+    REQUIRE(list.size() == 16);
+    REQUIRE(list[15] == 15 * 7);
+
+    Tracked::live = 0;
+    {
+        SeqList<Tracked, 0, Mapped> tracked;
+        for (int i = 0; i < 300000; ++i) {   // Past the threshold, element-wise moves
+            tracked.pushBack(Tracked(i));
+        }
+        REQUIRE(tracked[299999].value == 299999);
+        REQUIRE(Tracked::live == 300000);
+    }
+    REQUIRE(Tracked::live == 0);
+}
@@ -0,0 +1,113 @@
+// test_soa_seq_list.cpp
+// Catch2 unit tests for template class SoASeqList<Fields...>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "soa_seq_list.hpp"
+#include <string>
+#include <tuple>
+
+using ds::SoASeqList;
+
+using Rows = SoASeqList<int, double, std::string>;
+
+// -----------------------------------------------------------------------------
+// Basic state
+// -----------------------------------------------------------------------------
+TEST_CASE("SoASeqList default-constructed container is empty", "[constructor]") {
+    Rows list;
+    REQUIRE(list.empty());
+    REQUIRE(list.size() == 0);
+    REQUIRE(Rows::kFieldCount == 3);
+}
+
+// -----------------------------------------------------------------------------
+// pushBack / insert / erase / popBack keep the columns in step
+// -----------------------------------------------------------------------------
+TEST_CASE("SoASeqList row operations keep columns aligned", "[push][insert][erase]") {
+    Rows list;
+    list.pushBack(1, 1.5, "one");
+    list.pushBack(std::make_tuple(3, 3.5, std::string("three")));
+    REQUIRE(list.insert(1, 2, 2.5, "two"));
+    REQUIRE_FALSE(list.insert(9, 0, 0.0, ""));
+
+    REQUIRE(list.size() == 3);
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(list.column<0>()[i] == i + 1);
+        REQUIRE(list.column<1>()[i] == i + 1.5);
+    }
+    REQUIRE(list[1].get<2>() == "two");
+
+    REQUIRE(list.erase(0));
+    REQUIRE_FALSE(list.erase(2));
+    REQUIRE(list[0].get<0>() == 2);
+    REQUIRE(list[0].get<2>() == "two");
+
+    list.popBack();
+    REQUIRE(list.size() == 1);
+    list.clear();
+    REQUIRE(list.empty());
+}
+
+// -----------------------------------------------------------------------------
+// Proxy references
+// -----------------------------------------------------------------------------
+TEST_CASE("SoASeqList references read and write whole rows", "[proxy]") {
+    Rows list;
+    list.pushBack(1, 1.0, "a");
+    list.pushBack(2, 2.0, "b");
+
+    Rows::value_type row = list[0];
+    REQUIRE(row == std::make_tuple(1, 1.0, std::string("a")));
+
+    list[0] = std::make_tuple(7, 7.0, std::string("g"));
+    REQUIRE(list[0].get<0>() == 7);
+
+    list[1] = list[0];                  // Copies the row, not the proxy
+    list[0].get<2>() = "changed";
+    REQUIRE(list[1].get<2>() == "g");
+
+    list.set(1, std::make_tuple(9, 9.0, std::string("i")));
+    const Rows& view = list;
+    REQUIRE(view[1].get<1>() == 9.0);
+    REQUIRE(static_cast<Rows::value_type>(view[1]) == std::make_tuple(9, 9.0, std::string("i")));
+
+    list.pushBack(list[1]);             // A row of the list itself
+    REQUIRE(list.size() == 3);
+    REQUIRE(list[2].get<2>() == "i");
+}
+
+// -----------------------------------------------------------------------------
+// Column access
+// -----------------------------------------------------------------------------
+TEST_CASE("SoASeqList columns are contiguous and searchable", "[column]") {
+    SoASeqList<int, float> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.pushBack(i % 100, static_cast<float>(i));
+    }
+
+    const int* ids = list.column<0>();
+    long long sum = 0;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        sum += ids[i];
+    }
+    REQUIRE(sum == 10 * 4950);
+
+    REQUIRE(list.find<0>(42) == 42);
+    REQUIRE(list.find<1>(500.0f) == 500);
+    REQUIRE(list.find<0>(100) == SoASeqList<int, float>::npos);
+    REQUIRE(list.columnList<0>().count(7) == 10);
+}
+
+TEST_CASE("SoASeqList copies and moves every column", "[copy][move]") {
+    Rows a;
+    a.pushBack(1, 1.0, "x");
+    Rows b = a;
+    b[0].get<2>() = "y";
+    REQUIRE(a[0].get<2>() == "x");
+
+    Rows c = std::move(b);
+    REQUIRE(c.size() == 1);
+    REQUIRE(c[0].get<2>() == "y");
+}
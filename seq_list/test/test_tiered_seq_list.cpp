@@ -0,0 +1,225 @@
+// test_tiered_seq_list.cpp
+// Catch2 unit tests for template class TieredSeqList<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "tiered_seq_list.hpp"
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ds::TieredSeqList;
+
+namespace {
+
+// Counts live instances so that leaks and double destruction show up
+struct Tracked {
+    static int live;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { --live; }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
+int Tracked::live = 0;
+
+// Counts live instances too; a copy throws once the budget runs out
+struct Throwing {
+    static int live;
+    static int budget;                  // Copies allowed before one throws
+    int value;
+
+    explicit Throwing(int v) : value(v) { ++live; }
+    Throwing(const Throwing& other) : value(other.value) {
+        if (--budget < 0) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+    Throwing(Throwing&& other) noexcept : value(other.value) { ++live; }
+    Throwing& operator=(const Throwing&) = default;
+    ~Throwing() { --live; }
+};
+
+int Throwing::live = 0;
+int Throwing::budget = 0;
+
+template <typename T>
+bool sameAs(const TieredSeqList<T>& list, const std::vector<T>& expected) {
+    if (list.size() != expected.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        if (!(list[i] == expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Basic state and the SeqList API
+// -----------------------------------------------------------------------------
+TEST_CASE("TieredSeqList default-constructed container is empty", "[constructor]") {
+    TieredSeqList<int> list;
+    REQUIRE(list.empty());
+    REQUIRE(list.size() == 0);
+    REQUIRE(list.find(1) == TieredSeqList<int>::npos);
+}
+
+TEST_CASE("TieredSeqList push, pop, insert, erase and set", "[push][pop][insert][erase]") {
+    TieredSeqList<int> list;
+    list.pushBack(2);
+    list.pushFront(1);
+    list.pushBack(4);
+    REQUIRE(list.insert(2, 3));         // {1, 2, 3, 4}
+    REQUIRE_FALSE(list.insert(9, 0));
+    REQUIRE(sameAs(list, {1, 2, 3, 4}));
+
+    REQUIRE(list.erase(1));             // {1, 3, 4}
+    REQUIRE_FALSE(list.erase(3));
+    list.set(0, 7);                     // {7, 3, 4}
+    REQUIRE(sameAs(list, {7, 3, 4}));
+
+    list.popFront();
+    list.popBack();
+    REQUIRE(sameAs(list, {3}));
+    list.clear();
+    REQUIRE(list.empty());
+}
+
+// -----------------------------------------------------------------------------
+// Randomized comparison against std::vector, across block rebuilds
+// -----------------------------------------------------------------------------
+TEST_CASE("TieredSeqList matches std::vector under random edits", "[random]") {
+    std::mt19937 rng(11);
+    TieredSeqList<int> list;
+    std::vector<int> expected;
+
+    // Grow well past several block-size doublings, then shrink back down
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 20000; ++i) {
+            std::size_t pos = rng() % (expected.size() + 1);
+            int value = static_cast<int>(rng());
+            if (rng() % 4 == 0 && !expected.empty()) {
+                pos = rng() % expected.size();
+                list.erase(pos);
+                expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+            } else {
+                list.insert(pos, value);
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), value);
+            }
+        }
+        REQUIRE(sameAs(list, expected));
+
+        while (expected.size() > 100) {
+            std::size_t pos = rng() % expected.size();
+            list.erase(pos);
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+        REQUIRE(sameAs(list, expected));
+    }
+
+    int probe = expected[expected.size() / 2];
+    std::size_t first = 0;
+    while (expected[first] != probe) {
+        ++first;
+    }
+    REQUIRE(list.find(probe) == first);
+}
+
+TEST_CASE("TieredSeqList pushFront keeps reverse order", "[push][front]") {
+    TieredSeqList<int> list;
+    for (int i = 0; i < 5000; ++i) {
+        list.pushFront(i);
+    }
+    REQUIRE(list.size() == 5000);
+    for (int i = 0; i < 5000; ++i) {
+        REQUIRE(list[i] == 4999 - i);
+    }
+    REQUIRE(list.find(0) == 4999);
+
+    while (!list.empty()) {
+        list.popFront();
+    }
+    REQUIRE(list.empty());
+}
+
+// -----------------------------------------------------------------------------
+// Element lifetime, copies and moves
+// -----------------------------------------------------------------------------
+TEST_CASE("TieredSeqList constructs and destroys each element once", "[lifetime]") {
+    Tracked::live = 0;
+    {
+        TieredSeqList<Tracked> list;
+        for (int i = 0; i < 3000; ++i) {
+            list.insert(list.size() / 2, Tracked(i));
+        }
+        list.pushFront(list[10]);       // Reference into the list
+        REQUIRE(Tracked::live == 3001);
+        REQUIRE(list[0] == list[11]);
+
+        for (int i = 0; i < 2000; ++i) {
+            list.erase(list.size() / 3);
+        }
+        REQUIRE(Tracked::live == 1001);
+
+        TieredSeqList<Tracked> copy = list;
+        REQUIRE(Tracked::live == 2002);
+        TieredSeqList<Tracked> moved = std::move(copy);
+        REQUIRE(Tracked::live == 2002);
+        REQUIRE(moved.size() == list.size());
+        REQUIRE(moved[500] == list[500]);
+    }
+    REQUIRE(Tracked::live == 0);
+}
+
+TEST_CASE("TieredSeqList copy that throws midway frees what it built", "[copy][exception]") {
+    Throwing::live = 0;
+    {
+        TieredSeqList<Throwing> list;
+        for (int i = 0; i < 100; ++i) {
+            list.pushBack(Throwing(i));
+        }
+        REQUIRE(Throwing::live == 100);
+
+        Throwing::budget = 70;          // Several blocks in, the 71st copy throws
+        REQUIRE_THROWS_AS(TieredSeqList<Throwing>(list), std::runtime_error);
+        REQUIRE(Throwing::live == 100);
+        REQUIRE(list.size() == 100);
+        REQUIRE(list[99].value == 99);
+    }
+    REQUIRE(Throwing::live == 0);
+}
+
+TEST_CASE("TieredSeqList copy and move assignment", "[copy][move]") {
+    TieredSeqList<std::string> a;
+    for (int i = 0; i < 300; ++i) {
+        a.pushBack(std::to_string(i));
+    }
+
+    TieredSeqList<std::string> b;
+    b.pushBack("x");
+    b = a;
+    REQUIRE(b.size() == 300);
+    REQUIRE(b[299] == "299");
+
+    b.set(0, "changed");
+    REQUIRE(a[0] == "0");           // Deep copy
+
+    TieredSeqList<std::string> c;
+    c = std::move(b);
+    REQUIRE(c.size() == 300);
+    REQUIRE(c[0] == "changed");
+}
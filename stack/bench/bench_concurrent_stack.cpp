@@ -0,0 +1,81 @@
+// bench_concurrent_stack.cpp
+// Push/pop throughput of ConcurrentStack against a Stack behind a mutex,
+// with 1 to 64 threads sharing one stack, as an object pool's free list would.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "concurrent_stack.hpp"
+#include "stack.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kOperations = 4000000;   // pushes plus pops, all threads together
+
+class LockedStack {
+public:
+    void push(void* value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stack_.push(value);
+    }
+
+    bool tryPop(void*& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stack_.empty()) {
+            return false;
+        }
+        out = stack_.top();
+        stack_.pop();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    ds::Stack<void*> stack_;
+};
+
+// Each thread alternately frees an object into the pool and takes one back
+template <class Pool>
+double run(std::size_t threads) {
+    Pool pool;
+    std::vector<char> objects(threads);
+    std::size_t rounds = kOperations / 2 / threads;
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, &objects, rounds, t] {
+            void* object = &objects[t];
+            for (std::size_t i = 0; i < rounds; ++i) {
+                pool.push(object);
+                while (!pool.tryPop(object)) {
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(rounds * 2 * threads) / seconds / 1e6;
+}
+
+} // namespace
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    for (std::size_t threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        double locked = run<LockedStack>(threads);
+        double lockFree = run<ds::ConcurrentStack<void*>>(threads);
+        std::printf("threads=%-3zu mutex+Stack %8.2f Mops/s   ConcurrentStack %8.2f Mops/s   x%.2f\n",
+                    threads, locked, lockFree, lockFree / locked);
+    }
+    return 0;
+}
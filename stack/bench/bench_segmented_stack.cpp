@@ -0,0 +1,55 @@
+// bench_segmented_stack.cpp
+// Per-push latency percentiles of Stack against SegmentedStack while
+// growing to a large depth: Stack's rare relocations show up in the tail.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "segmented_stack.hpp"
+#include "stack.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double percentile(const std::vector<double>& sorted, double p) {
+    return sorted[static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1))];
+}
+
+template <class Stack, class Make>
+void run(const char* name, std::size_t n, Make make) {
+    std::vector<double> pauses(n);
+    Stack s;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto value = make(i);
+        auto start = Clock::now();
+        s.push(std::move(value));
+        pauses[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    std::sort(pauses.begin(), pauses.end());
+
+    std::printf("%-34s n=%-9zu p50 %7.0f ns   p99 %7.0f ns   p99.9 %7.0f ns   max %10.0f ns\n",
+                name, n, percentile(pauses, 0.5), percentile(pauses, 0.99),
+                percentile(pauses, 0.999), pauses.back());
+}
+
+} // namespace
+
+int main() {
+    auto number = [](std::size_t i) { return static_cast<std::uint64_t>(i); };
+    auto text = [](std::size_t i) { return std::to_string(i); };
+
+    for (std::size_t n : {1000000u, 16000000u}) {
+        run<ds::Stack<std::uint64_t>>("Stack<uint64_t>", n, number);
+        run<ds::SegmentedStack<std::uint64_t>>("SegmentedStack<uint64_t>", n, number);
+        run<ds::Stack<std::string>>("Stack<string>", n / 4, text);
+        run<ds::SegmentedStack<std::string>>("SegmentedStack<string>", n / 4, text);
+    }
+    return 0;
+}
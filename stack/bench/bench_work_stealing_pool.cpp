@@ -0,0 +1,106 @@
+// bench_work_stealing_pool.cpp
+// Fork/join workloads on WorkStealingPool: recursive fib and parallel
+// quicksort, against the same code run sequentially, at several pool sizes.
+//
+// Build with optimizations, e.g. -DCMAKE_BUILD_TYPE=Release.
+
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+long fib(int n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+// Every call above the cutoff is one spawned task, so this mostly measures
+// the cost of spawn, pop and steal
+long fib(ds::WorkStealingPool& pool, int n) {
+    if (n < 16) {
+        return fib(n);
+    }
+    long left = 0;
+    ds::WorkStealingPool::TaskGroup group;
+    pool.spawn(group, [&] { left = fib(pool, n - 1); });
+    long right = fib(pool, n - 2);
+    pool.wait(group);
+    return left + right;
+}
+
+void quicksort(ds::WorkStealingPool& pool, std::uint32_t* first, std::uint32_t* last) {
+    if (last - first < 4096) {
+        std::sort(first, last);
+        return;
+    }
+    std::uint32_t pivot = first[(last - first) / 2];
+    std::uint32_t* middle = std::partition(first, last, [pivot](std::uint32_t v) { return v < pivot; });
+    std::uint32_t* upper = std::partition(middle, last, [pivot](std::uint32_t v) { return v == pivot; });
+
+    ds::WorkStealingPool::TaskGroup group;
+    pool.spawn(group, [&pool, first, middle] { quicksort(pool, first, middle); });
+    quicksort(pool, upper, last);
+    pool.wait(group);
+}
+
+void runFib(int n) {
+    auto start = Clock::now();
+    long expected = fib(n);
+    double sequential = since(start);
+    std::printf("fib(%d)      sequential            %8.3f s\n", n, sequential);
+
+    for (std::size_t threads : {1u, 2u, 4u, 8u}) {
+        ds::WorkStealingPool pool(threads);
+        start = Clock::now();
+        long result = fib(pool, n);
+        double parallel = since(start);
+        std::printf("fib(%d)      pool threads=%-2zu       %8.3f s   x%.2f%s\n", n, threads,
+                    parallel, sequential / parallel, result == expected ? "" : "   WRONG");
+    }
+}
+
+void runSort(std::size_t n) {
+    std::vector<std::uint32_t> input(n);
+    std::mt19937 rng(42);
+    for (auto& v : input) {
+        v = rng();
+    }
+
+    std::vector<std::uint32_t> data = input;
+    auto start = Clock::now();
+    std::sort(data.begin(), data.end());
+    double sequential = since(start);
+    std::printf("sort n=%-8zu std::sort            %8.3f s\n", n, sequential);
+
+    for (std::size_t threads : {1u, 2u, 4u, 8u}) {
+        ds::WorkStealingPool pool(threads);
+        data = input;
+        start = Clock::now();
+        quicksort(pool, data.data(), data.data() + data.size());
+        double parallel = since(start);
+        std::printf("sort n=%-8zu pool threads=%-2zu       %8.3f s   x%.2f%s\n", n, threads,
+                    parallel, sequential / parallel,
+                    std::is_sorted(data.begin(), data.end()) ? "" : "   WRONG");
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    runFib(40);
+    runSort(20000000);
+    return 0;
+}
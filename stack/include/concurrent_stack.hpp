@@ -0,0 +1,180 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ds{
+
+// ConcurrentStack: a lock-free LIFO stack (Treiber stack) that any number of
+// threads may push to and pop from at once.
+//
+// The head is a single 64-bit word: a 48-bit node pointer and a 16-bit tag
+// that changes on every update, so a pop that read a head which was popped
+// and pushed again in the meantime (the ABA problem) fails its CAS instead
+// of corrupting the list.
+//
+// Popped nodes are not freed but kept on a lock-free free list and reused
+// by later pushes. A thread that lost a race may still read a node's next
+// pointer after the node was popped; because the node's memory stays a node
+// until the stack is destroyed, that read is always safe. Memory is returned
+// when the stack is destroyed, which must not race with other operations.
+template<typename T>
+class ConcurrentStack{
+public:
+    using size_type = std::size_t;
+
+    ConcurrentStack() = default;
+    ~ConcurrentStack();
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    template<class U>
+    void push(U&& value);
+
+    // Moves the top element into out. Returns false if the stack was empty.
+    bool tryPop(T& out);
+
+    // Both are snapshots that other threads may already have changed
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        alignas(T) unsigned char bytes[sizeof(T)];
+
+        T* value() noexcept { return reinterpret_cast<T*>(bytes); }
+    };
+
+    using Word = std::uint64_t;
+
+    static_assert(sizeof(void*) == 8, "ConcurrentStack packs pointers into 48 bits");
+
+    static constexpr unsigned kPointerBits = 48;
+    static constexpr Word kPointerMask = (Word{1} << kPointerBits) - 1;
+
+    static Node* pointerOf(Word word) noexcept {
+        return reinterpret_cast<Node*>(static_cast<std::uintptr_t>(word & kPointerMask));
+    }
+
+    // The tag wraps around, which is fine: a stale head would have to see
+    // exactly 65536 updates before its CAS to be fooled
+    static Word pack(Node* node, Word previous) noexcept {
+        Word tag = (previous >> kPointerBits) + 1;
+        return (reinterpret_cast<std::uintptr_t>(node) & kPointerMask) | (tag << kPointerBits);
+    }
+
+    static void pushNode(std::atomic<Word>& list, Node* node) noexcept;
+    static Node* popNode(std::atomic<Word>& list) noexcept;
+
+    Node* acquireNode();
+
+private:
+    std::atomic<Word> head_{0};
+    std::atomic<Word> free_{0};             // popped nodes, kept for reuse
+    std::atomic<size_type> size_{0};
+};
+
+template<typename T>
+ConcurrentStack<T>::~ConcurrentStack() {
+    for (Node* node = pointerOf(head_.load(std::memory_order_acquire)); node != nullptr;) {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        std::destroy_at(node->value());
+        delete node;
+        node = next;
+    }
+    for (Node* node = pointerOf(free_.load(std::memory_order_acquire)); node != nullptr;) {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+template<typename T>
+template<class U>
+void ConcurrentStack<T>::push(U&& value) {
+    Node* node = acquireNode();
+    try {
+        ::new (static_cast<void*>(node->value())) T(std::forward<U>(value));
+    } catch (...) {
+        pushNode(free_, node);
+        throw;
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    pushNode(head_, node);
+}
+
+// Only the thread whose CAS unlinked the node touches its value
+template<typename T>
+bool ConcurrentStack<T>::tryPop(T& out) {
+    Node* node = popNode(head_);
+    if (node == nullptr) {
+        return false;
+    }
+    try {
+        out = std::move(*node->value());
+    } catch (...) {
+        pushNode(head_, node);
+        throw;
+    }
+    std::destroy_at(node->value());
+    pushNode(free_, node);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename T>
+bool ConcurrentStack<T>::empty() const noexcept {
+    return pointerOf(head_.load(std::memory_order_relaxed)) == nullptr;
+}
+
+// A push counts its node before publishing it and a pop uncounts one after
+// unlinking it, so the counter may briefly read high but never goes below
+// the number of elements, and a decrement never overtakes its increment
+template<typename T>
+typename ConcurrentStack<T>::size_type ConcurrentStack<T>::size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+}
+
+// Release publishes the node's value and next pointer to the popping thread
+template<typename T>
+void ConcurrentStack<T>::pushNode(std::atomic<Word>& list, Node* node) noexcept {
+    Word old = list.load(std::memory_order_relaxed);
+    do {
+        node->next.store(pointerOf(old), std::memory_order_relaxed);
+    } while (!list.compare_exchange_weak(old, pack(node, old),
+                                         std::memory_order_release, std::memory_order_relaxed));
+}
+
+// The node read from old may be popped and reused by another thread while
+// we read its next pointer; then the tag has moved on and the CAS fails
+template<typename T>
+typename ConcurrentStack<T>::Node* ConcurrentStack<T>::popNode(std::atomic<Word>& list) noexcept {
+    Word old = list.load(std::memory_order_acquire);
+    for (;;) {
+        Node* node = pointerOf(old);
+        if (node == nullptr) {
+            return nullptr;
+        }
+        Node* next = node->next.load(std::memory_order_relaxed);
+        if (list.compare_exchange_weak(old, pack(next, old),
+                                       std::memory_order_acquire, std::memory_order_acquire)) {
+            return node;
+        }
+    }
+}
+
+template<typename T>
+typename ConcurrentStack<T>::Node* ConcurrentStack<T>::acquireNode() {
+    if (Node* node = popNode(free_)) {
+        return node;
+    }
+    return new Node;
+}
+
+}
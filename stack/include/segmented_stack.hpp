@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ds{
+
+// SegmentedStack: a stack stored as a chain of fixed-size chunks.
+//
+// A full chunk is never grown or copied; the next push starts a new chunk
+// on top of it. push and pop are therefore O(1) in the worst case, not just
+// amortized, and elements never move, so references to them stay valid
+// until they are popped. The most recently emptied chunk is kept as a
+// spare, so pushing and popping across a chunk boundary does not allocate.
+template<typename T, std::size_t ChunkSize = (sizeof(T) <= 256 ? 4096 / sizeof(T) : 16)>
+class SegmentedStack{
+    static_assert(ChunkSize > 0, "chunks must hold at least one element");
+
+public:
+    using size_type = std::size_t;
+
+    SegmentedStack() = default;
+    ~SegmentedStack();
+
+    SegmentedStack(const SegmentedStack& other);
+    SegmentedStack& operator=(SegmentedStack other) noexcept;
+
+    SegmentedStack(SegmentedStack&& other) noexcept;
+
+    template<class U>
+    void push(U&& value);
+
+    void pop();
+
+    T& top();
+    const T& top() const;
+
+    bool empty() const;
+    size_type size() const;
+
+    void clear() noexcept;
+
+private:
+    struct Chunk {
+        Chunk* prev = nullptr;      // the chunk below, full
+        alignas(T) unsigned char bytes[ChunkSize * sizeof(T)];
+
+        T* slots() noexcept { return reinterpret_cast<T*>(bytes); }
+    };
+
+    Chunk* acquireChunk();
+    void recycleChunk(Chunk* chunk) noexcept;
+
+    // Destroys a chain whose top chunk holds topCount elements
+    static void destroyChain(Chunk* top, size_type topCount) noexcept;
+
+    void swap(SegmentedStack& other) noexcept;
+
+private:
+    Chunk* top_ = nullptr;          // nullptr when empty
+    size_type topCount_ = 0;        // elements in the top chunk, 1..ChunkSize
+    size_type size_ = 0;
+    Chunk* spare_ = nullptr;        // most recently emptied chunk
+};
+
+template<typename T, std::size_t ChunkSize>
+SegmentedStack<T, ChunkSize>::~SegmentedStack() {
+    destroyChain(top_, topCount_);
+    delete spare_;
+    top_ = nullptr;
+    spare_ = nullptr;
+    size_ = 0;
+    topCount_ = 0;
+}
+
+// Copies from the top chunk down, linking each new chunk below the last
+template<typename T, std::size_t ChunkSize>
+SegmentedStack<T, ChunkSize>::SegmentedStack(const SegmentedStack& other) {
+    Chunk** below = &top_;
+    try {
+        for (Chunk* source = other.top_; source != nullptr; source = source->prev) {
+            size_type count = source == other.top_ ? other.topCount_ : ChunkSize;
+            Chunk* chunk = new Chunk;
+            try {
+                std::uninitialized_copy(source->slots(), source->slots() + count, chunk->slots());
+            } catch (...) {
+                delete chunk;
+                throw;
+            }
+            *below = chunk;
+            below = &chunk->prev;
+        }
+    } catch (...) {
+        destroyChain(top_, other.topCount_);
+        top_ = nullptr;
+        throw;
+    }
+    topCount_ = other.topCount_;
+    size_ = other.size_;
+}
+
+template<typename T, std::size_t ChunkSize>
+SegmentedStack<T, ChunkSize>& SegmentedStack<T, ChunkSize>::operator=(SegmentedStack other) noexcept {
+    swap(other);
+    return *this;
+}
+
+template<typename T, std::size_t ChunkSize>
+SegmentedStack<T, ChunkSize>::SegmentedStack(SegmentedStack&& other) noexcept
+    :top_(other.top_), topCount_(other.topCount_), size_(other.size_), spare_(other.spare_) {
+    other.top_ = nullptr;
+    other.topCount_ = 0;
+    other.size_ = 0;
+    other.spare_ = nullptr;
+}
+
+// Chunks never move, so value may safely refer to an element of this stack
+template<typename T, std::size_t ChunkSize>
+template<class U>
+void SegmentedStack<T, ChunkSize>::push(U&& value) {
+    if (top_ != nullptr && topCount_ < ChunkSize) {
+        ::new (static_cast<void*>(top_->slots() + topCount_)) T(std::forward<U>(value));
+        ++topCount_;
+        ++size_;
+        return;
+    }
+
+    Chunk* chunk = acquireChunk();
+    try {
+        ::new (static_cast<void*>(chunk->slots())) T(std::forward<U>(value));
+    } catch (...) {
+        recycleChunk(chunk);
+        throw;
+    }
+    chunk->prev = top_;
+    top_ = chunk;
+    topCount_ = 1;
+    ++size_;
+}
+
+template<typename T, std::size_t ChunkSize>
+void SegmentedStack<T, ChunkSize>::pop() {
+    assert(size_ > 0 && "Stack underflow");
+    --topCount_;
+    --size_;
+    std::destroy_at(top_->slots() + topCount_);
+
+    if (topCount_ == 0) {
+        Chunk* emptied = top_;
+        top_ = emptied->prev;
+        topCount_ = top_ != nullptr ? ChunkSize : 0;
+        recycleChunk(emptied);
+    }
+}
+
+template <typename T, std::size_t ChunkSize>
+T& SegmentedStack<T, ChunkSize>::top() {
+    assert(size_ > 0 && "Empty stack");
+    return top_->slots()[topCount_ - 1];
+}
+
+template <typename T, std::size_t ChunkSize>
+const T& SegmentedStack<T, ChunkSize>::top() const {
+    assert(size_ > 0 && "Empty stack");
+    return top_->slots()[topCount_ - 1];
+}
+
+template <typename T, std::size_t ChunkSize>
+typename SegmentedStack<T, ChunkSize>::size_type SegmentedStack<T, ChunkSize>::size() const {
+    return size_;
+}
+
+template <typename T, std::size_t ChunkSize>
+bool SegmentedStack<T, ChunkSize>::empty() const {
+    return size_ == 0;
+}
+
+// Keeps the top chunk as the spare, so a cleared stack can refill one
+// chunk without allocating
+template <typename T, std::size_t ChunkSize>
+void SegmentedStack<T, ChunkSize>::clear() noexcept {
+    if (top_ == nullptr) {
+        return;
+    }
+    Chunk* keep = top_;
+    std::destroy(keep->slots(), keep->slots() + topCount_);
+    destroyChain(keep->prev, ChunkSize);
+    top_ = nullptr;
+    topCount_ = 0;
+    size_ = 0;
+    recycleChunk(keep);
+}
+
+template<typename T, std::size_t ChunkSize>
+typename SegmentedStack<T, ChunkSize>::Chunk* SegmentedStack<T, ChunkSize>::acquireChunk() {
+    if (spare_ != nullptr) {
+        return std::exchange(spare_, nullptr);
+    }
+    return new Chunk;
+}
+
+// The newest empty chunk becomes the spare; an older spare is freed
+template<typename T, std::size_t ChunkSize>
+void SegmentedStack<T, ChunkSize>::recycleChunk(Chunk* chunk) noexcept {
+    delete spare_;
+    chunk->prev = nullptr;
+    spare_ = chunk;
+}
+
+template<typename T, std::size_t ChunkSize>
+void SegmentedStack<T, ChunkSize>::destroyChain(Chunk* top, size_type topCount) noexcept {
+    size_type count = topCount;
+    while (top != nullptr) {
+        Chunk* below = top->prev;
+        std::destroy(top->slots(), top->slots() + count);
+        delete top;
+        top = below;
+        count = ChunkSize;
+    }
+}
+
+template<typename T, std::size_t ChunkSize>
+void SegmentedStack<T, ChunkSize>::swap(SegmentedStack& other) noexcept{
+    using std::swap;
+    swap(top_, other.top_);
+    swap(topCount_, other.topCount_);
+    swap(size_, other.size_);
+    swap(spare_, other.spare_);
+}
+
+}
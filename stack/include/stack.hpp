@@ -2,11 +2,18 @@
 
 #include <cstddef>
 #include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
+#include "growth_policy.hpp"
+
 namespace ds{
 
-template<typename T>
+// Growth is the growth policy (growth_policy.hpp): how far the buffer grows
+// and where its memory comes from.
+template<typename T, class Growth = GeometricGrowth<>>
 class Stack{
 public:
     using size_type = std::size_t;
@@ -32,109 +39,190 @@ public:
     bool empty() const;
     size_type size() const;
 
+    // A checkpoint of the stack's depth, for backtracking. Marks nest: after
+    // rolling back to one, any mark taken before it is still valid.
+    struct Mark {
+        size_type depth;
+    };
+
+    Mark mark() const noexcept;
+
+    // Pops every element pushed since m. O(1) for trivially destructible T.
+    void rollbackTo(Mark m) noexcept;
+
+    // As above, but first calls undo(element) on each popped element, top
+    // first, e.g. to restore the state a trail entry records
+    template<class Undo>
+    void rollbackTo(Mark m, Undo&& undo);
+
 private:
     void ensureCapacity();
+    void reallocate(size_type newCapacity);
     void swap(Stack& other) noexcept;
 
 private:
     size_type size_ = 0;
     size_type capacity_ = 0;
-    T* data_ = nullptr;
-    
-    static constexpr size_type kInitialCapacity = 4;
+    T* data_ = nullptr;         // uninitialized storage, [0, size_) is constructed
 };
 
-template<typename T>
-Stack<T>::Stack()
-    :size_(0), capacity_(kInitialCapacity), data_(new T[kInitialCapacity]){}
+template<typename T, class Growth>
+Stack<T, Growth>::Stack()
+    :size_(0),
+     capacity_(Growth::template nextCapacity<T>(0, 1)),
+     data_(Growth::template allocate<T>(capacity_)){}
 
-template<typename T>
-Stack<T>::~Stack() {
-    delete[] data_;
+template<typename T, class Growth>
+Stack<T, Growth>::~Stack() {
+    std::destroy(data_, data_ + size_);
+    Growth::template deallocate<T>(data_, capacity_);
     data_ = nullptr;
     size_ = 0;
     capacity_ = 0;
 }
 
-template<typename T>
-Stack<T>::Stack(const Stack<T>& other)
-    :size_(other.size_), capacity_(other.capacity_), data_(new T(other.capacity_)) {
-    for (size_type i = 0; i < size_; ++i) {
-        data_[i] = other.data_[i];
+template<typename T, class Growth>
+Stack<T, Growth>::Stack(const Stack<T, Growth>& other)
+    :size_(0), capacity_(other.capacity_), data_(Growth::template allocate<T>(other.capacity_)) {
+    try {
+        std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+    } catch (...) {
+        Growth::template deallocate<T>(data_, capacity_);
+        throw;
     }
+    size_ = other.size_;
 }
 
-template<typename T>
-Stack<T>& Stack<T>::operator=(Stack<T> other) noexcept{
+template<typename T, class Growth>
+Stack<T, Growth>& Stack<T, Growth>::operator=(Stack<T, Growth> other) noexcept{
     swap(other);
     return *this;
 }
 
-template<typename T>
-Stack<T>::Stack(Stack<T>&& other) noexcept
+template<typename T, class Growth>
+Stack<T, Growth>::Stack(Stack<T, Growth>&& other) noexcept
     :size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
     other.data_ = nullptr;
     other.size_ = 0;
     other.capacity_ = 0;
 }
 
-// template<typename T>
-// Stack<T>& Stack<T>::operator=(Stack<T>&& other) noexcept {
+// template<typename T, class Growth>
+// Stack<T, Growth>& Stack<T, Growth>::operator=(Stack<T, Growth>&& other) noexcept {
 //     swap(other);
 //     return *this;
 // }
 
-template<typename T>
+template<typename T, class Growth>
 template<class U>
-void Stack<T>::push(U&& value) {
+void Stack<T, Growth>::push(U&& value) {
+    if (size_ < capacity_) {
+        ::new (static_cast<void*>(data_ + size_)) T(std::forward<U>(value));
+        ++size_;
+        return;
+    }
+
+    // value may be top() itself, so materialize it before growth moves it
+    T tmp(std::forward<U>(value));
     ensureCapacity();
-    data_[size_++] = std::forward<U>(value);
+    ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
+    ++size_;
 }
 
-template<typename T>
-void Stack<T>::pop() {
+template<typename T, class Growth>
+void Stack<T, Growth>::pop() {
     assert(size_ > 0 && "Stack underflow");
     --size_;
+    std::destroy_at(data_ + size_);
 }
 
-template <typename T>
-T& Stack<T>::top() {
+template <typename T, class Growth>
+T& Stack<T, Growth>::top() {
     assert(size_ > 0 && "Empty stack");
     return data_[size_ - 1];
 }
 
-template <typename T>
-const T& Stack<T>::top() const {
+template <typename T, class Growth>
+const T& Stack<T, Growth>::top() const {
     assert(size_ > 0 && "Empty stack");
     return data_[size_ - 1];
 }
 
-template <typename T>
-typename Stack<T>::size_type Stack<T>::size() const {
+template <typename T, class Growth>
+typename Stack<T, Growth>::size_type Stack<T, Growth>::size() const {
     return size_;
 }
 
-template <typename T>
-bool Stack<T>::empty() const {
+template <typename T, class Growth>
+bool Stack<T, Growth>::empty() const {
     return size_ == 0;
 }
 
-template<typename T>
-void Stack<T>::ensureCapacity() {
+template <typename T, class Growth>
+typename Stack<T, Growth>::Mark Stack<T, Growth>::mark() const noexcept {
+    return Mark{size_};
+}
+
+// For trivially destructible T, destroy is a no-op and this is one store
+template <typename T, class Growth>
+void Stack<T, Growth>::rollbackTo(Mark m) noexcept {
+    assert(m.depth <= size_ && "Mark is above the top of the stack");
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        std::destroy(data_ + m.depth, data_ + size_);
+    }
+    size_ = m.depth;
+}
+
+// Each element is popped right after its undo returns, so if undo throws the
+// stack stops at the element that failed, which is still in place
+template <typename T, class Growth>
+template <class Undo>
+void Stack<T, Growth>::rollbackTo(Mark m, Undo&& undo) {
+    assert(m.depth <= size_ && "Mark is above the top of the stack");
+    while (size_ > m.depth) {
+        undo(data_[size_ - 1]);
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+}
+
+template<typename T, class Growth>
+void Stack<T, Growth>::ensureCapacity() {
     if (size_ >= capacity_) {
-        size_type newCapacity = capacity_ == 0 ? kInitialCapacity : capacity_ * 2;
-        T* newData = new T[newCapacity];
-        for (size_type i = 0; i < size_; ++i) {
-            newData[i] = std::move_if_noexcept(data_[i]);
+        reallocate(Growth::template nextCapacity<T>(capacity_, size_ + 1));
+    }
+}
+
+// Trivially relocatable elements move as bytes, through the policy
+// (realloc, mremap); others are moved one by one into a new buffer
+template<typename T, class Growth>
+void Stack<T, Growth>::reallocate(size_type newCapacity) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        data_ = Growth::template reallocate<T>(data_, capacity_, newCapacity);
+        capacity_ = newCapacity;
+    } else {
+        T* newData = Growth::template allocate<T>(newCapacity);
+        try {
+            // Fall back to copying when a throwing move could lose elements
+            if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                          !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(data_, data_ + size_, newData);
+            } else {
+                std::uninitialized_copy(data_, data_ + size_, newData);
+            }
+        } catch (...) {
+            Growth::template deallocate<T>(newData, newCapacity);
+            throw;
         }
-        delete[] data_;
+        std::destroy(data_, data_ + size_);
+        Growth::template deallocate<T>(data_, capacity_);
         data_ = newData;
         capacity_ = newCapacity;
     }
 }
 
-template<typename T>
-void Stack<T>::swap(Stack<T>& other) noexcept{
+template<typename T, class Growth>
+void Stack<T, Growth>::swap(Stack<T, Growth>& other) noexcept{
     using std::swap;
     swap(size_, other.size_);
     swap(capacity_, other.capacity_);
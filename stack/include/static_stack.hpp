@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+namespace ds{
+
+// StaticStack: a stack of at most N elements stored inline, like std::array.
+//
+// It never allocates, so constructing one costs nothing beyond initializing
+// its slots, and every operation is constexpr: a StaticStack can be used in
+// compile-time evaluation, e.g. by a parser running in a constexpr function.
+// To stay constexpr in C++17 the slots are always-alive objects rather than
+// raw storage, so T must be default constructible; pop() resets the slot
+// for types that own resources. Pushing onto a full stack is a bug, caught
+// by assert (and by the compiler in constant evaluation).
+template<typename T, std::size_t N>
+class StaticStack{
+    static_assert(std::is_default_constructible_v<T>,
+                  "StaticStack keeps every slot alive and needs default-constructible T");
+
+public:
+    using size_type = std::size_t;
+
+    constexpr StaticStack() = default;
+
+    template<class U>
+    constexpr void push(U&& value);
+
+    constexpr void pop();
+
+    constexpr T& top();
+    constexpr const T& top() const;
+
+    constexpr bool empty() const;
+    constexpr bool full() const;
+    constexpr size_type size() const;
+    static constexpr size_type capacity() { return N; }
+
+private:
+    std::array<T, N> data_{};
+    size_type size_ = 0;
+};
+
+template<typename T, std::size_t N>
+template<class U>
+constexpr void StaticStack<T, N>::push(U&& value) {
+    assert(size_ < N && "Stack overflow");
+    data_[size_] = std::forward<U>(value);
+    ++size_;
+}
+
+template<typename T, std::size_t N>
+constexpr void StaticStack<T, N>::pop() {
+    assert(size_ > 0 && "Stack underflow");
+    --size_;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        data_[size_] = T();         // Release what the popped element owned
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr T& StaticStack<T, N>::top() {
+    assert(size_ > 0 && "Empty stack");
+    return data_[size_ - 1];
+}
+
+template<typename T, std::size_t N>
+constexpr const T& StaticStack<T, N>::top() const {
+    assert(size_ > 0 && "Empty stack");
+    return data_[size_ - 1];
+}
+
+template<typename T, std::size_t N>
+constexpr bool StaticStack<T, N>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, std::size_t N>
+constexpr bool StaticStack<T, N>::full() const {
+    return size_ == N;
+}
+
+template<typename T, std::size_t N>
+constexpr typename StaticStack<T, N>::size_type StaticStack<T, N>::size() const {
+    return size_;
+}
+
+}
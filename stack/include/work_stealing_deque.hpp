@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ds{
+
+// WorkStealingDeque: the Chase-Lev work-stealing deque.
+//
+// One owner thread uses it as a stack: push and pop at the bottom. Any
+// number of thieves take the oldest element from the top with steal. The
+// owner's push and pop are plain loads and stores; only popping the very
+// last element, which a thief may be stealing at the same moment, needs a
+// CAS. Thieves always use a CAS on top.
+//
+// The elements live in a power-of-two circular array that the owner doubles
+// when it fills. A thief may still be reading the old array, so retired
+// arrays are kept, chained to the new one, until the deque is destroyed;
+// their total size never exceeds that of the current array.
+//
+// Elements are copied in and out of atomic slots, so T must be trivially
+// copyable; a scheduler stores task pointers.
+template<typename T>
+class WorkStealingDeque{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "WorkStealingDeque stores elements in atomic slots");
+
+public:
+    using size_type = std::size_t;
+
+    explicit WorkStealingDeque(size_type capacity = 64);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only
+    void push(T value);
+    bool pop(T& out);
+
+    // Any thread. Fails if the deque is empty or another thread won the
+    // race for the top element.
+    bool steal(T& out);
+
+    // Snapshots, exact only when no other thread is working on the deque
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+
+    size_type capacity() const noexcept;
+
+private:
+    struct Array {
+        explicit Array(std::int64_t cap)
+            :mask(cap - 1), slots(new std::atomic<T>[static_cast<size_type>(cap)]) {}
+        ~Array() { delete[] slots; }
+
+        T get(std::int64_t index) const noexcept {
+            return slots[index & mask].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t index, T value) noexcept {
+            slots[index & mask].store(value, std::memory_order_relaxed);
+        }
+        std::int64_t capacity() const noexcept { return mask + 1; }
+
+        std::int64_t mask;
+        std::atomic<T>* slots;
+        Array* retired = nullptr;       // the array this one replaced
+    };
+
+    Array* grow(Array* array, std::int64_t bottom, std::int64_t top);
+
+private:
+    // top is written by thieves, bottom by the owner: keep them apart
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    alignas(64) std::atomic<Array*> array_;
+};
+
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_type capacity) {
+    std::int64_t cap = 1;
+    while (static_cast<size_type>(cap) < capacity) {
+        cap <<= 1;
+    }
+    array_.store(new Array(cap), std::memory_order_relaxed);
+}
+
+template<typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    Array* array = array_.load(std::memory_order_relaxed);
+    while (array != nullptr) {
+        Array* older = array->retired;
+        delete array;
+        array = older;
+    }
+}
+
+// Publishing the new bottom with release hands the element, and anything
+// it points to, to a thief that reads bottom with acquire
+template<typename T>
+void WorkStealingDeque<T>::push(T value) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity() - 1) {
+        array = grow(array, bottom, top);
+    }
+    array->put(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+// Claims the bottom slot first, then looks at top: the seq_cst fence pairs
+// with the one in steal, so the owner and a thief cannot both miss each
+// other's claim on the last element
+template<typename T>
+bool WorkStealingDeque<T>::pop(T& out) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {                 // Empty
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    out = array->get(bottom);
+    if (top < bottom) {                 // More than one left: no thief can reach it
+        return true;
+    }
+
+    bool won = top_.compare_exchange_strong(top, top + 1,
+                                            std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::steal(T& out) {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+
+    // Read before the CAS: once top moves on, the owner may overwrite the slot
+    Array* array = array_.load(std::memory_order_acquire);
+    T value = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template<typename T>
+typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::size() const noexcept {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+}
+
+template<typename T>
+typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::capacity() const noexcept {
+    return static_cast<size_type>(array_.load(std::memory_order_relaxed)->capacity());
+}
+
+// Copies the live range [top, bottom) to the same indices of an array twice
+// the size; thieves that loaded the old array still read valid elements
+template<typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(Array* array, std::int64_t bottom, std::int64_t top) {
+    Array* bigger = new Array(array->capacity() * 2);
+    for (std::int64_t i = top; i < bottom; ++i) {
+        bigger->put(i, array->get(i));
+    }
+    bigger->retired = array;
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+}
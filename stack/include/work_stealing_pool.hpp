@@ -0,0 +1,257 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "stack.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace ds{
+
+// WorkStealingPool: a fork/join thread pool built on WorkStealingDeque.
+//
+// Each worker owns a deque. A task spawned from a worker goes to the bottom
+// of that worker's deque and is usually run by the same worker, newest
+// first, while its caches are still warm. An idle worker steals the oldest
+// task from a random victim; in fork/join code that is the largest piece of
+// work left, so steals are rare. Tasks spawned from outside the pool go to
+// a shared inbox.
+//
+// spawn adds a task to a TaskGroup and wait returns once every task in the
+// group has finished. A waiting thread runs other tasks in the meantime, so
+// tasks may spawn and wait recursively without tying up workers:
+//
+//     WorkStealingPool::TaskGroup group;
+//     pool.spawn(group, [&] { left = fib(pool, n - 1); });
+//     right = fib(pool, n - 2);
+//     pool.wait(group);
+//
+// Tasks must not throw. Tasks still queued when the pool is destroyed are
+// dropped without running.
+class WorkStealingPool{
+public:
+    using size_type = std::size_t;
+
+    class TaskGroup {
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        bool done() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class WorkStealingPool;
+        std::atomic<size_type> pending_{0};
+    };
+
+    explicit WorkStealingPool(size_type threads = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    template<class F>
+    void spawn(TaskGroup& group, F&& task);
+
+    // Runs queued tasks until every task in group has finished
+    void wait(TaskGroup& group);
+
+    size_type threadCount() const noexcept;
+
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+        WorkStealingPool* pool = nullptr;
+        std::uint64_t seed = 0;
+    };
+
+    Worker* currentWorker() const noexcept;
+    Task* findTask(Worker* self);
+    bool runOne(Worker* self);
+    void workerLoop(Worker* self);
+    void wakeOne();
+
+    // Spins this many times without finding work before going to sleep
+    static constexpr size_type kIdleSpins = 64;
+
+private:
+    size_type threadCount_;
+    std::unique_ptr<Worker[]> workers_;
+
+    std::mutex inboxMutex_;
+    Stack<Task*> inbox_;
+    std::atomic<size_type> inboxSize_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<size_type> sleepers_{0};
+    std::atomic<bool> stop_{false};
+
+    // The worker the calling thread runs, in whichever pool
+    static inline thread_local Worker* current_ = nullptr;
+};
+
+inline WorkStealingPool::WorkStealingPool(size_type threads)
+    :threadCount_(threads > 0 ? threads : 1), workers_(new Worker[threadCount_]) {
+    for (size_type i = 0; i < threadCount_; ++i) {
+        workers_[i].pool = this;
+        workers_[i].seed = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    for (size_type i = 0; i < threadCount_; ++i) {
+        workers_[i].thread = std::thread([this, i] { workerLoop(&workers_[i]); });
+    }
+}
+
+inline WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_.store(true, std::memory_order_release);
+    }
+    wake_.notify_all();
+    for (size_type i = 0; i < threadCount_; ++i) {
+        workers_[i].thread.join();
+    }
+
+    Task* task = nullptr;
+    for (size_type i = 0; i < threadCount_; ++i) {
+        while (workers_[i].deque.pop(task)) {
+            delete task;
+        }
+    }
+    while (!inbox_.empty()) {
+        delete inbox_.top();
+        inbox_.pop();
+    }
+}
+
+template<class F>
+void WorkStealingPool::spawn(TaskGroup& group, F&& task) {
+    Task* entry = new Task{std::function<void()>(std::forward<F>(task)), &group};
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+    if (Worker* self = currentWorker()) {
+        self->deque.push(entry);
+    } else {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        inbox_.push(entry);
+        inboxSize_.fetch_add(1, std::memory_order_release);
+    }
+    wakeOne();
+}
+
+inline void WorkStealingPool::wait(TaskGroup& group) {
+    Worker* self = currentWorker();
+    while (!group.done()) {
+        if (!runOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline WorkStealingPool::size_type WorkStealingPool::threadCount() const noexcept {
+    return threadCount_;
+}
+
+// Only the pool's own workers may touch a deque's bottom
+inline WorkStealingPool::Worker* WorkStealingPool::currentWorker() const noexcept {
+    Worker* self = current_;
+    return self != nullptr && self->pool == this ? self : nullptr;
+}
+
+// Own deque first, then the inbox, then one pass over the other workers
+// starting at a random victim
+inline WorkStealingPool::Task* WorkStealingPool::findTask(Worker* self) {
+    Task* task = nullptr;
+    if (self != nullptr && self->deque.pop(task)) {
+        return task;
+    }
+
+    if (inboxSize_.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        if (!inbox_.empty()) {
+            task = inbox_.top();
+            inbox_.pop();
+            inboxSize_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    size_type start = 0;
+    if (self != nullptr) {
+        // xorshift64
+        self->seed ^= self->seed << 13;
+        self->seed ^= self->seed >> 7;
+        self->seed ^= self->seed << 17;
+        start = static_cast<size_type>(self->seed % threadCount_);
+    }
+    for (size_type i = 0; i < threadCount_; ++i) {
+        Worker& victim = workers_[(start + i) % threadCount_];
+        if (&victim != self && victim.deque.steal(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+// Finishing a task releases its effects to whoever sees the group done
+inline bool WorkStealingPool::runOne(Worker* self) {
+    Task* task = findTask(self);
+    if (task == nullptr) {
+        return false;
+    }
+    task->run();
+    TaskGroup* group = task->group;
+    delete task;
+    group->pending_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+// A sleeping worker wakes up at least every millisecond, so a wake-up that
+// races with falling asleep costs latency, never progress
+inline void WorkStealingPool::workerLoop(Worker* self) {
+    current_ = self;
+    size_type idle = 0;
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (runOne(self)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < kIdleSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (!stop_.load(std::memory_order_relaxed)) {
+            sleepers_.fetch_add(1, std::memory_order_relaxed);
+            wake_.wait_for(lock, std::chrono::milliseconds(1));
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        idle = 0;
+    }
+    current_ = nullptr;
+}
+
+inline void WorkStealingPool::wakeOne() {
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        wake_.notify_one();
+    }
+}
+
+}
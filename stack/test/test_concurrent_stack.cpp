@@ -0,0 +1,166 @@
+// test_concurrent_stack.cpp
+// Catch2 unit tests for template class ConcurrentStack<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "concurrent_stack.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ds::ConcurrentStack;
+
+// -----------------------------------------------------------------------------
+// Single-threaded behaviour
+// -----------------------------------------------------------------------------
+TEST_CASE("ConcurrentStack is LIFO", "[push][pop]") {
+    ConcurrentStack<int> s;
+    REQUIRE(s.empty());
+
+    int out = -1;
+    REQUIRE_FALSE(s.tryPop(out));
+    REQUIRE(out == -1);
+
+    s.push(1);
+    s.push(2);
+    s.push(3);
+    REQUIRE(s.size() == 3);
+
+    REQUIRE(s.tryPop(out));
+    REQUIRE(out == 3);
+    REQUIRE(s.tryPop(out));
+    REQUIRE(out == 2);
+
+    s.push(4);                          // Reuses a popped node
+    REQUIRE(s.tryPop(out));
+    REQUIRE(out == 4);
+    REQUIRE(s.tryPop(out));
+    REQUIRE(out == 1);
+    REQUIRE(s.empty());
+    REQUIRE(s.size() == 0);
+}
+
+TEST_CASE("ConcurrentStack owns its elements", "[lifetime]") {
+    auto shared = std::make_shared<int>(7);
+    {
+        ConcurrentStack<std::shared_ptr<int>> s;
+        s.push(shared);
+        s.push(shared);
+        REQUIRE(shared.use_count() == 3);
+
+        std::shared_ptr<int> out;
+        REQUIRE(s.tryPop(out));
+        REQUIRE(*out == 7);
+        out.reset();
+        REQUIRE(shared.use_count() == 2);
+    }
+    REQUIRE(shared.use_count() == 1);   // The destructor released the rest
+}
+
+// -----------------------------------------------------------------------------
+// Concurrent use
+// -----------------------------------------------------------------------------
+TEST_CASE("every pushed value is popped exactly once", "[thread]") {
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 20000;
+
+    ConcurrentStack<int> s;
+    std::vector<std::atomic<int>> seen(kThreads * kPerThread);
+    std::vector<std::thread> threads;
+
+    // Every thread pushes its own range and pops as much as it pushes, so
+    // nodes are constantly unlinked and reused under contention
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            int out;
+            for (int i = 0; i < kPerThread; ++i) {
+                s.push(t * kPerThread + i);
+                if (i % 2 == 1) {
+                    for (int k = 0; k < 2; ++k) {
+                        while (!s.tryPop(out)) {
+                        }
+                        seen[out].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(s.empty());
+    REQUIRE(s.size() == 0);
+    int wrong = 0;
+    for (auto& count : seen) {
+        wrong += count.load() != 1;
+    }
+    REQUIRE(wrong == 0);
+}
+
+TEST_CASE("values pushed by one thread arrive intact in another", "[thread]") {
+    constexpr int kCount = 10000;
+    const std::string prefix(40, 'x');  // Long enough to live on the heap
+
+    ConcurrentStack<std::string> s;
+    long long sum = 0;
+    int torn = 0;
+
+    std::thread consumer([&] {
+        std::string out;
+        for (int received = 0; received < kCount;) {
+            if (s.tryPop(out)) {
+                torn += out.compare(0, prefix.size(), prefix) != 0;
+                sum += std::stoi(out.substr(prefix.size()));
+                ++received;
+            }
+        }
+    });
+    for (int i = 0; i < kCount; ++i) {
+        s.push(prefix + std::to_string(i));
+    }
+    consumer.join();
+
+    REQUIRE(torn == 0);
+    REQUIRE(sum == static_cast<long long>(kCount) * (kCount - 1) / 2);
+    REQUIRE(s.empty());
+}
+
+TEST_CASE("size never exceeds the pushes made under concurrent push and pop", "[thread]") {
+    constexpr int kPairs = 4;
+    constexpr int kPerThread = 50000;
+
+    ConcurrentStack<int> s;
+    std::atomic<int> wrapped{0};
+    std::vector<std::thread> threads;
+
+    // Each pusher's values are popped as soon as they land, so the stack stays
+    // near empty; a decrement that landed before the matching increment would
+    // wrap the counter to about SIZE_MAX, which the popper sees right away
+    for (int t = 0; t < kPairs; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kPerThread; ++i) {
+                s.push(i);
+            }
+        });
+        threads.emplace_back([&] {
+            int out;
+            for (int popped = 0; popped < kPerThread;) {
+                if (s.tryPop(out)) {
+                    ++popped;
+                    wrapped.fetch_add(s.size() > std::size_t(kPairs) * kPerThread,
+                                      std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(wrapped.load() == 0);
+    REQUIRE(s.size() == 0);
+}
@@ -0,0 +1,167 @@
+// test_segmented_stack.cpp
+// Catch2 unit tests for template class SegmentedStack<T, ChunkSize>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "segmented_stack.hpp"
+#include <stdexcept>
+#include <string>
+
+using ds::SegmentedStack;
+
+namespace {
+
+// Counts live objects, so that a leaked or double-destroyed element shows up.
+// Copying a negative value throws; moving never does.
+struct Tracked {
+    static int live;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) {
+        if (other.value < 0) {
+            throw std::runtime_error("copy refused");
+        }
+        ++live;
+    }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    ~Tracked() { --live; }
+};
+
+int Tracked::live = 0;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// push / pop / top
+// -----------------------------------------------------------------------------
+TEST_CASE("SegmentedStack is LIFO across chunk boundaries", "[push][pop][top]") {
+    SegmentedStack<int, 4> s;
+    REQUIRE(s.empty());
+
+    for (int i = 0; i < 23; ++i) {
+        s.push(i);
+        REQUIRE(s.top() == i);
+    }
+    REQUIRE(s.size() == 23);
+
+    for (int i = 22; i >= 0; --i) {
+        REQUIRE(s.top() == i);
+        s.pop();
+    }
+    REQUIRE(s.empty());
+    REQUIRE(s.size() == 0);
+}
+
+TEST_CASE("SegmentedStack never relocates its elements", "[push][stability]") {
+    SegmentedStack<std::string, 8> s;
+    s.push(std::string(32, 'x'));
+    const std::string* bottom = &s.top();
+
+    for (int i = 0; i < 1000; ++i) {
+        s.push(std::to_string(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        s.pop();
+    }
+    REQUIRE(&s.top() == bottom);
+    REQUIRE(s.top() == std::string(32, 'x'));
+}
+
+TEST_CASE("push may copy an element of the same stack", "[push][alias]") {
+    SegmentedStack<std::string, 2> s;
+    s.push(std::string(40, 'a'));
+    s.push(s.top());                    // Fills the first chunk
+    s.push(s.top());                    // Starts a new chunk
+    REQUIRE(s.size() == 3);
+    REQUIRE(s.top() == std::string(40, 'a'));
+}
+
+TEST_CASE("oscillating at a chunk boundary reuses the spare chunk", "[pop][spare]") {
+    SegmentedStack<int, 4> s;
+    for (int i = 0; i < 4; ++i) {
+        s.push(i);
+    }
+    s.push(4);
+    const int* fresh = &s.top();        // First slot of the second chunk
+
+    for (int round = 0; round < 100; ++round) {
+        s.pop();                        // Second chunk becomes the spare
+        s.push(round);                  // and is taken back
+        REQUIRE(&s.top() == fresh);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Copy, move, clear and element lifetime
+// -----------------------------------------------------------------------------
+TEST_CASE("copies are deep and moves transfer the chunks", "[copy][move]") {
+    SegmentedStack<std::string, 3> s;
+    for (int i = 0; i < 10; ++i) {
+        s.push(std::to_string(i));
+    }
+
+    SegmentedStack<std::string, 3> copy = s;
+    s.pop();
+    REQUIRE(copy.size() == 10);
+    REQUIRE(copy.top() == "9");
+
+    SegmentedStack<std::string, 3> moved = std::move(copy);
+    REQUIRE(moved.size() == 10);
+    REQUIRE(copy.empty());              // Moved-from stack is empty but usable
+    copy.push("again");
+    REQUIRE(copy.top() == "again");
+
+    copy = moved;
+    for (int i = 9; i >= 0; --i) {
+        REQUIRE(copy.top() == std::to_string(i));
+        copy.pop();
+    }
+}
+
+TEST_CASE("every element is destroyed exactly once", "[clear][lifetime]") {
+    Tracked::live = 0;
+    {
+        SegmentedStack<Tracked, 4> s;
+        for (int i = 0; i < 10; ++i) {
+            s.push(Tracked(i));
+        }
+        REQUIRE(Tracked::live == 10);
+
+        s.pop();
+        REQUIRE(Tracked::live == 9);
+
+        s.clear();
+        REQUIRE(s.empty());
+        REQUIRE(Tracked::live == 0);
+
+        for (int i = 0; i < 6; ++i) {
+            s.push(Tracked(i));
+        }
+        REQUIRE(s.top().value == 5);
+    }
+    REQUIRE(Tracked::live == 0);
+}
+
+TEST_CASE("a failed copy leaves nothing behind", "[copy][exception]") {
+    Tracked::live = 0;
+    {
+        using Small = SegmentedStack<Tracked, 4>;
+        Small s;
+        for (int i = 0; i < 9; ++i) {
+            s.push(Tracked(i));
+        }
+        s.push(Tracked(-1));            // Refuses to be copied, in the third chunk
+        s.push(Tracked(10));
+
+        REQUIRE_THROWS_AS(Small(s), std::runtime_error);
+        REQUIRE(Tracked::live == 11);
+
+        Tracked refused(-1);
+        REQUIRE_THROWS_AS(s.push(refused), std::runtime_error);
+        REQUIRE(s.size() == 11);
+        REQUIRE(s.top().value == 10);
+    }
+    REQUIRE(Tracked::live == 0);
+}
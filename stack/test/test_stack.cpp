@@ -135,4 +135,128 @@ TEST_CASE("Stack supports move semantics in push", "[push][move]") {
     s.push(std::string("world"));
     REQUIRE(s.top() == "world");
     REQUIRE(s.size() == 2);
-}
\ No newline at end of file
+}
+
+// -----------------------------------------------------------------------------
+// Growth policies and element lifetime
+// -----------------------------------------------------------------------------
+TEST_CASE("Stack grows through the chosen policy", "[growth][policy]") {
+    SECTION("fixed step, non-trivial elements") {
+        Stack<std::string, ds::FixedStepGrowth<3>> s;
+        for (int i = 0; i < 10; ++i) {
+            s.push(std::to_string(i));
+        }
+        s.push(s.top());            // Reference into the stack across a growth
+        REQUIRE(s.size() == 11);
+        REQUIRE(s.top() == "9");
+
+        Stack<std::string, ds::FixedStepGrowth<3>> copy = s;
+        s.pop();
+        REQUIRE(copy.size() == 11);
+        REQUIRE(s.top() == "9");
+    }
+
+    SECTION("mapped storage for a large trivially copyable stack") {
+        Stack<long, ds::MappedGrowth<>> s;
+        const long n = 1 << 20;     // 8 MiB: remapped more than once
+        for (long i = 0; i < n; ++i) {
+            s.push(i);
+        }
+        REQUIRE(s.size() == static_cast<std::size_t>(n));
+        for (long i = n - 1; i >= n - 100; --i) {
+            REQUIRE(s.top() == i);
+            s.pop();
+        }
+    }
+}
+
+TEST_CASE("Stack destroys every element it constructs", "[lifetime]") {
+    static int live = 0;
+    struct Tracked {
+        Tracked() { ++live; }
+        Tracked(const Tracked&) { ++live; }
+        ~Tracked() { --live; }
+    };
+
+    {
+        Stack<Tracked> s;
+        for (int i = 0; i < 20; ++i) {
+            s.push(Tracked());
+        }
+        s.pop();
+        Stack<Tracked> copy = s;
+        REQUIRE(live == 38);
+    }
+    REQUIRE(live == 0);
+}
+// -----------------------------------------------------------------------------
+// Marks and rollback
+// -----------------------------------------------------------------------------
+TEST_CASE("rollbackTo truncates to nested marks", "[mark][rollback]") {
+    Stack<int> trail;
+    trail.push(1);
+    auto outer = trail.mark();
+    trail.push(2);
+    trail.push(3);
+    auto inner = trail.mark();
+    trail.push(4);
+
+    trail.rollbackTo(inner);
+    REQUIRE(trail.size() == 3);
+    REQUIRE(trail.top() == 3);
+
+    trail.rollbackTo(inner);            // Rolling back to the same depth is a no-op
+    REQUIRE(trail.size() == 3);
+
+    trail.push(5);
+    trail.rollbackTo(outer);
+    REQUIRE(trail.size() == 1);
+    REQUIRE(trail.top() == 1);
+
+    trail.rollbackTo(Stack<int>::Mark{0});
+    REQUIRE(trail.empty());
+}
+
+TEST_CASE("rollbackTo calls undo on each popped element, top first", "[mark][rollback]") {
+    int variables[4] = {0, 0, 0, 0};
+    struct Assignment {
+        int variable;
+        int previous;
+    };
+
+    Stack<Assignment> trail;
+    auto assign = [&](int variable, int value) {
+        trail.push(Assignment{variable, variables[variable]});
+        variables[variable] = value;
+    };
+
+    assign(0, 7);
+    auto decision = trail.mark();
+    assign(1, 8);
+    assign(1, 9);                       // The same variable twice: order matters
+    assign(2, 10);
+
+    std::string order;
+    trail.rollbackTo(decision, [&](const Assignment& a) {
+        variables[a.variable] = a.previous;
+        order += std::to_string(a.variable);
+    });
+
+    REQUIRE(order == "211");
+    REQUIRE(variables[0] == 7);
+    REQUIRE(variables[1] == 0);
+    REQUIRE(variables[2] == 0);
+    REQUIRE(trail.size() == 1);
+}
+
+TEST_CASE("rollbackTo destroys the elements it removes", "[mark][rollback][lifetime]") {
+    Stack<std::string> s;
+    auto empty = s.mark();
+    for (int i = 0; i < 10; ++i) {
+        s.push(std::string(40, static_cast<char>('a' + i)));
+    }
+    s.rollbackTo(empty);
+    REQUIRE(s.empty());
+    s.push("again");
+    REQUIRE(s.top() == "again");
+}
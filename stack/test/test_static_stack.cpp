@@ -0,0 +1,114 @@
+// test_static_stack.cpp
+// Catch2 unit tests for template class StaticStack<T, N>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "static_stack.hpp"
+#include <memory>
+#include <string>
+
+using ds::StaticStack;
+
+namespace {
+
+// Evaluates a postfix expression of single digits, '+', '-' and '*'
+constexpr int evaluate(const char* expression) {
+    StaticStack<int, 16> operands;
+    for (const char* c = expression; *c != '\0'; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            operands.push(*c - '0');
+            continue;
+        }
+        int right = operands.top();
+        operands.pop();
+        int left = operands.top();
+        operands.pop();
+        operands.push(*c == '+' ? left + right : *c == '-' ? left - right : left * right);
+    }
+    return operands.top();
+}
+
+// Returns true if every bracket is closed by the matching kind
+constexpr bool balanced(const char* text) {
+    StaticStack<char, 32> open;
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '(' || *c == '[' || *c == '{') {
+            open.push(*c);
+        } else if (*c == ')' || *c == ']' || *c == '}') {
+            char expected = *c == ')' ? '(' : *c == ']' ? '[' : '{';
+            if (open.empty() || open.top() != expected) {
+                return false;
+            }
+            open.pop();
+        }
+    }
+    return open.empty();
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Compile-time use
+// -----------------------------------------------------------------------------
+static_assert(evaluate("34+2*") == 14);
+static_assert(evaluate("92-3*1+") == 22);
+static_assert(balanced("{a[b(c)]}()"));
+static_assert(!balanced("(]"));
+static_assert(!balanced("(("));
+static_assert(StaticStack<int, 8>::capacity() == 8);
+
+TEST_CASE("StaticStack works in constant expressions", "[constexpr]") {
+    constexpr int value = evaluate("12+3*");
+    REQUIRE(value == 9);
+    REQUIRE(balanced("([]{})"));
+}
+
+// -----------------------------------------------------------------------------
+// Run-time use
+// -----------------------------------------------------------------------------
+TEST_CASE("StaticStack push, pop and top", "[push][pop][top]") {
+    StaticStack<int, 3> s;
+    REQUIRE(s.empty());
+    REQUIRE_FALSE(s.full());
+
+    s.push(1);
+    s.push(2);
+    s.push(3);
+    REQUIRE(s.full());
+    REQUIRE(s.size() == 3);
+    REQUIRE(s.top() == 3);
+
+    s.top() = 30;
+    s.pop();
+    REQUIRE(s.top() == 2);
+    s.pop();
+    s.pop();
+    REQUIRE(s.empty());
+}
+
+TEST_CASE("StaticStack lives entirely inside the object", "[storage]") {
+    StaticStack<int, 64> s;
+    s.push(7);
+    auto* begin = reinterpret_cast<const char*>(&s);
+    auto* top = reinterpret_cast<const char*>(&s.top());
+    REQUIRE(top >= begin);
+    REQUIRE(top < begin + sizeof(s));
+}
+
+TEST_CASE("pop releases what the element owned", "[pop][lifetime]") {
+    auto shared = std::make_shared<int>(1);
+    StaticStack<std::shared_ptr<int>, 4> s;
+    s.push(shared);
+    s.push(shared);
+    REQUIRE(shared.use_count() == 3);
+
+    s.pop();
+    REQUIRE(shared.use_count() == 2);
+
+    StaticStack<std::string, 2> strings;
+    strings.push(std::string(40, 'a'));
+    StaticStack<std::string, 2> copy = strings;
+    strings.pop();
+    REQUIRE(copy.top() == std::string(40, 'a'));
+}
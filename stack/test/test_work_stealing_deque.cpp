@@ -0,0 +1,117 @@
+// test_work_stealing_deque.cpp
+// Catch2 unit tests for template class WorkStealingDeque<T>.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "work_stealing_deque.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using ds::WorkStealingDeque;
+
+// -----------------------------------------------------------------------------
+// Owner and thief ends
+// -----------------------------------------------------------------------------
+TEST_CASE("the owner pops newest first and thieves steal oldest first", "[pop][steal]") {
+    WorkStealingDeque<int> d(4);
+    REQUIRE(d.empty());
+
+    int out = -1;
+    REQUIRE_FALSE(d.pop(out));
+    REQUIRE_FALSE(d.steal(out));
+
+    for (int i = 0; i < 5; ++i) {
+        d.push(i);
+    }
+    REQUIRE(d.size() == 5);
+
+    REQUIRE(d.pop(out));
+    REQUIRE(out == 4);
+    REQUIRE(d.steal(out));
+    REQUIRE(out == 0);
+    REQUIRE(d.steal(out));
+    REQUIRE(out == 1);
+    REQUIRE(d.pop(out));
+    REQUIRE(out == 3);
+    REQUIRE(d.pop(out));
+    REQUIRE(out == 2);
+    REQUIRE(d.empty());
+    REQUIRE_FALSE(d.pop(out));
+}
+
+TEST_CASE("the circular array grows and keeps the order", "[push][grow]") {
+    WorkStealingDeque<int> d(2);
+    REQUIRE(d.capacity() == 2);
+
+    int out;
+    for (int round = 0; round < 3; ++round) {   // Indices wrap around the array
+        d.push(round);
+        REQUIRE(d.steal(out));
+    }
+    for (int i = 0; i < 100; ++i) {
+        d.push(i);
+    }
+    REQUIRE(d.capacity() >= 100);
+    REQUIRE(d.size() == 100);
+
+    for (int i = 0; i < 50; ++i) {
+        REQUIRE(d.steal(out));
+        REQUIRE(out == i);
+    }
+    for (int i = 99; i >= 50; --i) {
+        REQUIRE(d.pop(out));
+        REQUIRE(out == i);
+    }
+    REQUIRE(d.empty());
+}
+
+// -----------------------------------------------------------------------------
+// Concurrent owner and thieves
+// -----------------------------------------------------------------------------
+TEST_CASE("every pushed element is taken exactly once", "[thread]") {
+    constexpr int kItems = 100000;
+    constexpr int kThieves = 4;
+
+    WorkStealingDeque<int> d(8);            // Small, so the owner grows it under fire
+    std::vector<std::atomic<int>> taken(kItems);
+    std::atomic<bool> ownerDone{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t) {
+        thieves.emplace_back([&] {
+            int out;
+            while (!ownerDone.load() || !d.empty()) {
+                if (d.steal(out)) {
+                    taken[out].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // The owner pushes in bursts and pops part of each burst back, so it
+    // keeps racing the thieves for the last element
+    int out;
+    for (int i = 0; i < kItems; ++i) {
+        d.push(i);
+        if (i % 3 == 2) {
+            for (int k = 0; k < 2 && d.pop(out); ++k) {
+                taken[out].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    while (d.pop(out)) {
+        taken[out].fetch_add(1, std::memory_order_relaxed);
+    }
+    ownerDone = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    int wrong = 0;
+    for (auto& count : taken) {
+        wrong += count.load() != 1;
+    }
+    REQUIRE(wrong == 0);
+}
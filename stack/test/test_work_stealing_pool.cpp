@@ -0,0 +1,85 @@
+// test_work_stealing_pool.cpp
+// Catch2 unit tests for class WorkStealingPool.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "work_stealing_pool.hpp"
+#include <atomic>
+#include <vector>
+
+using ds::WorkStealingPool;
+
+namespace {
+
+long fib(WorkStealingPool& pool, int n) {
+    if (n < 12) {
+        return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+    long left = 0;
+    WorkStealingPool::TaskGroup group;
+    pool.spawn(group, [&] { left = fib(pool, n - 1); });
+    long right = fib(pool, n - 2);
+    pool.wait(group);
+    return left + right;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// spawn / wait
+// -----------------------------------------------------------------------------
+TEST_CASE("tasks spawned from outside the pool all run", "[spawn][wait]") {
+    WorkStealingPool pool(3);
+    REQUIRE(pool.threadCount() == 3);
+
+    std::vector<int> results(1000, 0);
+    WorkStealingPool::TaskGroup group;
+    for (int i = 0; i < 1000; ++i) {
+        pool.spawn(group, [&results, i] { results[i] = i * i; });
+    }
+    pool.wait(group);
+    REQUIRE(group.done());
+
+    int wrong = 0;
+    for (int i = 0; i < 1000; ++i) {
+        wrong += results[i] != i * i;
+    }
+    REQUIRE(wrong == 0);
+}
+
+TEST_CASE("recursive fork/join computes fib", "[spawn][wait][recursive]") {
+    for (WorkStealingPool::size_type threads : {1u, 2u, 4u}) {
+        WorkStealingPool pool(threads);
+        REQUIRE(fib(pool, 25) == 75025);
+    }
+}
+
+TEST_CASE("nested groups wait only for their own tasks", "[wait]") {
+    WorkStealingPool pool(2);
+    std::atomic<int> inner{0};
+    std::atomic<int> outer{0};
+
+    WorkStealingPool::TaskGroup group;
+    for (int i = 0; i < 8; ++i) {
+        pool.spawn(group, [&] {
+            WorkStealingPool::TaskGroup children;
+            for (int k = 0; k < 8; ++k) {
+                pool.spawn(children, [&] { inner.fetch_add(1); });
+            }
+            pool.wait(children);
+            outer.fetch_add(1);
+        });
+    }
+    pool.wait(group);
+
+    REQUIRE(inner.load() == 64);
+    REQUIRE(outer.load() == 8);
+}
+
+TEST_CASE("an idle pool shuts down cleanly", "[destructor]") {
+    WorkStealingPool pool(4);
+    WorkStealingPool::TaskGroup group;
+    REQUIRE(group.done());
+    pool.wait(group);                       // Nothing to wait for
+}